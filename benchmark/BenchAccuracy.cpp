@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BenchCommon.h"
+
+#include "ClockFrameDriver.h"
+
+#include <QtAlgorithms>
+
+#include <stdio.h>
+
+// Simulates one minute of frames
+#define ACCURACY_DURATION_MS (60000)
+
+// How late after the sync the time gets sampled on the render thread
+// and how late after the next sync the swap call returns
+#define ACCURACY_SAMPLE_JITTER_MS (2.0)
+#define ACCURACY_SWAP_JITTER_MS (0.5)
+
+enum AccuracyDriver {
+    DriverVsync,
+    DriverTimer,
+    DriverCount
+};
+
+static const char* const DRIVER_NAME[DriverCount] = {
+    "vsync",
+    "timer"
+};
+
+static const int ACCURACY_RATES[] = { 60, 120 };
+static const bool ACCURACY_PREDICT[] = { false, true };
+static const int ACCURACY_LATENCIES[] = { 1, 2 };
+
+// One frame showing the time iShown, on the screen from iPresented on
+struct AccuracySample {
+    double iPresented;
+    double iShown;
+    qreal iAngle;
+};
+
+// Sorted errors
+struct AccuracyResult {
+    QVector<double> iDegrees;
+    QVector<double> iMsecs;
+    QVector<double> iResidual;
+    double iEstimate;
+    int iUpdates;
+
+    static double percentile(const QVector<double>& aValues, int aPercent);
+};
+
+double
+AccuracyResult::percentile(
+    const QVector<double>& aValues,
+    int aPercent)
+{
+    const int n = aValues.count();
+    return n ? aValues.at(qMin((aPercent * n) / 100, n - 1)) : 0;
+}
+
+static QTime
+accuracyTime(
+    double aMs)
+{
+    return BENCH_START_TIME.addMSecs(qRound(aMs));
+}
+
+// Deterministic, so that the runs can be compared
+static double
+accuracyJitter(
+    quint32* aSeed,
+    double aMax)
+{
+    *aSeed = *aSeed * 1103515245 + 12345;
+    return aMax * ((*aSeed >> 16) & 0x7fff) / 0x8000;
+}
+
+// Samples the second hand the way QuickClockLayer does it: when driven
+// by vsync, on every sync; when driven by the timer, on the first sync
+// after the timer has fired. The time is sampled a bit after the sync,
+// the swap call returns a bit after the next sync and the frame reaches
+// the screen aLatency vsyncs after the sync it has been sampled at. The
+// error is measured at every vsync against the true time. With aPredict,
+// the sample and swap times are fed to ClockFrameDriver's moving average
+// and the hand is drawn for the sample time plus the current estimate,
+// the way ClockFrameDriver::presentTime() does it. The residual is the
+// difference between the time the frame shows and the time it reaches
+// the screen.
+static AccuracyResult
+accuracySimulate(
+    ClockRenderer* aRenderer,
+    int aRate,
+    AccuracyDriver aDriver,
+    int aLatency,
+    bool aPredict)
+{
+    const double period = 1000.0 / aRate;
+    const int vsyncs = (int)(ACCURACY_DURATION_MS / period);
+    QList<AccuracySample> samples;
+    AccuracyResult result;
+    quint32 seed = aRate;
+    int average = 0; // us
+    double timer = 0;
+
+    for (int k = 0; k < vsyncs; k++) {
+        const double sync = k * period;
+        if (aDriver == DriverVsync || sync >= timer) {
+            const double sampled = sync +
+                accuracyJitter(&seed, ACCURACY_SAMPLE_JITTER_MS);
+            const double swapped = sync + period +
+                accuracyJitter(&seed, ACCURACY_SWAP_JITTER_MS);
+            AccuracySample sample;
+            sample.iPresented = sync + aLatency * period;
+            sample.iShown = sampled + (aPredict ? (average / 1000.0) : 0);
+            const QTime t(accuracyTime(sample.iShown));
+            sample.iAngle = aRenderer->nodeAngle(ClockRenderer::NodeSec, t);
+            samples.append(sample);
+            result.iResidual.append(qAbs(sample.iPresented - sample.iShown));
+            average = ClockFrameDriver::averagePresentDelay(average,
+                qRound((swapped - sampled) * 1000));
+            timer = sync + qMax(aRenderer->msecUntilNextUpdate(
+                ClockRenderer::NodeSec, t), QUICK_CLOCK_MIN_UPDATE_INTERVAL);
+        }
+    }
+
+    result.iUpdates = samples.count();
+    result.iEstimate = average / 1000.0;
+    int shown = -1;
+    for (int j = 0; j < vsyncs; j++) {
+        const double now = j * period;
+        while (shown + 1 < samples.count() &&
+            samples.at(shown + 1).iPresented <= now) {
+            shown++;
+        }
+        if (shown >= 0) {
+            const AccuracySample& sample = samples.at(shown);
+            qreal diff = aRenderer->nodeAngle(ClockRenderer::NodeSec,
+                accuracyTime(now)) - sample.iAngle;
+            while (diff > 180) diff -= 360;
+            while (diff < -180) diff += 360;
+            result.iDegrees.append(qAbs(diff));
+            result.iMsecs.append(qAbs(now - sample.iShown));
+        }
+    }
+    qSort(result.iDegrees);
+    qSort(result.iMsecs);
+    qSort(result.iResidual);
+    return result;
+}
+
+static QJsonObject
+accuracyRun(
+    ClockRenderer* aRenderer,
+    int aRate,
+    AccuracyDriver aDriver,
+    int aLatency,
+    bool aPredict)
+{
+    const AccuracyResult res(accuracySimulate(aRenderer, aRate, aDriver,
+        aLatency, aPredict));
+    const double maxDeg = res.iDegrees.isEmpty() ? 0 : res.iDegrees.last();
+    QJsonObject result;
+    result.insert("style", aRenderer->id());
+    result.insert("rate", aRate);
+    result.insert("driver", QString(DRIVER_NAME[aDriver]));
+    result.insert("latency_frames", aLatency);
+    result.insert("predict", aPredict);
+    result.insert("updates", res.iUpdates);
+    result.insert("p50_deg", AccuracyResult::percentile(res.iDegrees, 50));
+    result.insert("p95_deg", AccuracyResult::percentile(res.iDegrees, 95));
+    result.insert("p99_deg", AccuracyResult::percentile(res.iDegrees, 99));
+    result.insert("max_deg", maxDeg);
+    result.insert("p50_ms", AccuracyResult::percentile(res.iMsecs, 50));
+    result.insert("p99_ms", AccuracyResult::percentile(res.iMsecs, 99));
+    result.insert("estimate_ms", res.iEstimate);
+    result.insert("residual_p50_ms",
+        AccuracyResult::percentile(res.iResidual, 50));
+    result.insert("residual_p99_ms",
+        AccuracyResult::percentile(res.iResidual, 99));
+    printf("%-14s %4d %-6s %7d %7s %7d %8.3f %8.3f %8.3f %8.3f %8.1f %8.1f "
+        "%8.2f %8.2f %8.2f\n", qPrintable(aRenderer->id()), aRate,
+        DRIVER_NAME[aDriver], aLatency, aPredict ? "yes" : "no",
+        res.iUpdates, AccuracyResult::percentile(res.iDegrees, 50),
+        AccuracyResult::percentile(res.iDegrees, 95),
+        AccuracyResult::percentile(res.iDegrees, 99), maxDeg,
+        AccuracyResult::percentile(res.iMsecs, 50),
+        AccuracyResult::percentile(res.iMsecs, 99), res.iEstimate,
+        AccuracyResult::percentile(res.iResidual, 50),
+        AccuracyResult::percentile(res.iResidual, 99));
+    fflush(stdout);
+    return result;
+}
+
+// How far the second hand on the screen is from where it should be, in
+// degrees and in milliseconds of the time it shows, with and without
+// present time prediction, and how far off the prediction is. Not a
+// timing benchmark, the frames are simulated.
+QJsonArray
+benchAccuracy(
+    const BenchOptions& aOptions)
+{
+    QJsonArray results;
+    QList<ClockRenderer*> renderers = benchRenderers(aOptions);
+
+    printf("%-14s %4s %-6s %7s %7s %7s %8s %8s %8s %8s %8s %8s %8s %8s "
+        "%8s\n", "style", "Hz", "driver", "latency", "predict", "updates",
+        "p50 deg", "p95 deg", "p99 deg", "max deg", "p50 ms", "p99 ms",
+        "estimate", "res p50", "res p99");
+    for (int i = 0; i < renderers.count(); i++) {
+        ClockRenderer* renderer = renderers.at(i);
+        for (uint r = 0; r < sizeof(ACCURACY_RATES)/sizeof(int); r++) {
+            const int rate = ACCURACY_RATES[r];
+            for (int d = 0; d < DriverCount; d++) {
+                for (uint l = 0; l < sizeof(ACCURACY_LATENCIES)/sizeof(int);
+                     l++) {
+                    for (uint p = 0; p < sizeof(ACCURACY_PREDICT)/sizeof(bool);
+                         p++) {
+                        results.append(accuracyRun(renderer, rate,
+                            (AccuracyDriver)d, ACCURACY_LATENCIES[l],
+                            ACCURACY_PREDICT[p]));
+                    }
+                }
+            }
+        }
+    }
+    return results;
+}
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BenchCommon.h"
+#include "BenchQuickHost.h"
+
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QSGTransformNode>
+#include <QCoreApplication>
+
+#include <stdio.h>
+
+// Multisampled render targets get huge quickly
+#define ANTIALIAS_MAX_SIZE (1080)
+#define ANTIALIAS_SAMPLES (16)
+
+// Hands at the angles where aliasing is clearly visible
+#define ANTIALIAS_TIME BENCH_START_TIME.addMSecs(37250)
+
+// The aliased variant claims a multisampled context (so that the nodes
+// are built without feathered edges) but renders into a single sampled
+// buffer
+enum AntialiasVariant {
+    AntialiasMultisampled,  // What we had (the reference)
+    AntialiasNone,          // No multisampling and no feathered edges
+    AntialiasFeathered,     // No multisampling, feathered edges
+    AntialiasVariantCount
+};
+
+static const char* const ANTIALIAS_VARIANT_NAME[AntialiasVariantCount] = {
+    "msaa",
+    "aliased",
+    "feathered"
+};
+
+// Hands (no dial plate) rendered once, at a fixed time
+class StaticClockItem : public QQuickItem {
+public:
+    StaticClockItem(QQuickItem* aParent, ClockRenderer* aRenderer,
+        ClockTheme* aTheme) : QQuickItem(aParent), iRenderer(aRenderer),
+        iTheme(aTheme) { setFlag(ItemHasContents); }
+
+protected:
+    QSGNode* updatePaintNode(QSGNode* aNode, UpdatePaintNodeData*)
+        Q_DECL_OVERRIDE;
+
+private:
+    ClockRenderer* iRenderer;
+    ClockTheme* iTheme;
+};
+
+QSGNode*
+StaticClockItem::updatePaintNode(
+    QSGNode* aNode,
+    UpdatePaintNodeData*)
+{
+    if (!aNode) {
+        const QSize size(width(), height());
+        aNode = new QSGNode;
+        for (int i = ClockRenderer::NodeHour; i <= ClockRenderer::NodeSec;
+             i++) {
+            // The second hand adds the center disk to the parent
+            const ClockRenderer::NodeType type = (ClockRenderer::NodeType)i;
+            QSGNode* parent = new QSGNode;
+            QSGTransformNode* tx = new QSGTransformNode;
+            tx->setMatrix(iRenderer->nodeMatrix(type, size, ANTIALIAS_TIME));
+            parent->appendChildNode(tx);
+            aNode->appendChildNode(parent);
+            iRenderer->initNode(tx, type, window(), size, iTheme);
+        }
+    }
+    return aNode;
+}
+
+// Renders the same frame over and over again
+class AntialiasCase {
+public:
+    AntialiasCase(BenchQuickHost* aHost) : iHost(aHost), iFrames(0) {}
+
+    void operator()(int) {
+        qint64 syncNs, renderNs;
+        iHost->frame(&syncNs, &renderNs);
+        // The first (warm-up) frame is not counted
+        if (iFrames++) {
+            iRender.add(renderNs, 0, 0);
+        }
+    }
+
+    BenchQuickHost* iHost;
+    int iFrames;
+    BenchSamples iRender;
+};
+
+// Mean difference (in 0..255 units) between the image and the reference,
+// only counting the pixels affected by antialiasing, i.e. those which
+// differ between the reference and the aliased image
+static qreal
+antialiasError(
+    const QImage& aImage,
+    const QImage& aReference,
+    const QImage& aAliased)
+{
+    qint64 total = 0;
+    int count = 0;
+    for (int y = 0; y < aReference.height(); y++) {
+        const QRgb* line = (const QRgb*)aImage.constScanLine(y);
+        const QRgb* ref = (const QRgb*)aReference.constScanLine(y);
+        const QRgb* aliased = (const QRgb*)aAliased.constScanLine(y);
+        for (int x = 0; x < aReference.width(); x++) {
+            if (ref[x] != aliased[x]) {
+                total += qMax(qMax(qAbs(qRed(line[x]) - qRed(ref[x])),
+                    qAbs(qGreen(line[x]) - qGreen(ref[x]))),
+                    qAbs(qBlue(line[x]) - qBlue(ref[x])));
+                count++;
+            }
+        }
+    }
+    return count ? ((qreal)total / count) : 0;
+}
+
+// Renders the hands with multisampling, without any antialiasing and
+// with feathered edges, and compares the time it takes and the result
+QJsonArray
+benchAntialias(
+    const BenchOptions& aOptions)
+{
+    QJsonArray results;
+    ClockTheme* theme = ClockTheme::defaultTheme();
+    QList<ClockRenderer*> renderers = benchRenderers(aOptions);
+
+    printf("%-14s %5s %-10s %7s %7s %12s %12s %8s\n", "style", "size",
+        "variant", "samples", "feather", "render us", "p95 us", "error");
+    for (int i = 0; i < renderers.count(); i++) {
+        ClockRenderer* renderer = renderers.at(i);
+        for (int j = 0; j < aOptions.iSizes.count(); j++) {
+            const int d = aOptions.iSizes.at(j);
+            if (d > ANTIALIAS_MAX_SIZE) {
+                continue;
+            }
+
+            QImage images[AntialiasVariantCount];
+            BenchSamples samples[AntialiasVariantCount];
+            int sampleCount[AntialiasVariantCount];
+            qreal feather[AntialiasVariantCount];
+            for (int v = 0; v < AntialiasVariantCount; v++) {
+                const QSize size(d, d);
+                BenchQuickHost host(size, (v == AntialiasMultisampled) ?
+                    ANTIALIAS_SAMPLES : 0, (v == AntialiasFeathered) ? 0 :
+                    ANTIALIAS_SAMPLES);
+                if (!host.isValid()) {
+                    fprintf(stderr, "Failed to initialize OpenGL\n");
+                    results.append(benchFailure("OpenGL"));
+                    return results;
+                }
+
+                // What the renderers are going to use
+                feather[v] = ClockRenderer::featherWidth(host.window());
+                host.window()->setColor(theme->iBackgroundColor);
+                StaticClockItem* item = new StaticClockItem(
+                    host.contentItem(), renderer, theme);
+                item->setSize(size);
+                QCoreApplication::processEvents();
+
+                AntialiasCase aaCase(&host);
+                benchRun(aOptions, aaCase);
+                samples[v] = aaCase.iRender;
+                sampleCount[v] = host.samples();
+                images[v] = host.grab();
+            }
+
+            // Without multisampling support there's no reference
+            const bool haveReference = sampleCount[AntialiasMultisampled] > 1;
+            for (int v = 0; v < AntialiasVariantCount; v++) {
+                const qreal error = haveReference ?
+                    antialiasError(images[v], images[AntialiasMultisampled],
+                    images[AntialiasNone]) : -1;
+                QJsonObject result;
+                result.insert("style", renderer->id());
+                result.insert("size", d);
+                result.insert("variant", QString(ANTIALIAS_VARIANT_NAME[v]));
+                result.insert("samples", sampleCount[v]);
+                result.insert("feather", feather[v]);
+                result.insert("render", samples[v].toJson());
+                result.insert("error", error);
+                results.append(result);
+                printf("%-14s %5d %-10s %7d %7.1f %12.1f %12.1f %8.1f\n",
+                    qPrintable(renderer->id()), d, ANTIALIAS_VARIANT_NAME[v],
+                    sampleCount[v], feather[v], samples[v].mean()/1000.0,
+                    samples[v].percentile(95)/1000.0, error);
+                fflush(stdout);
+            }
+        }
+    }
+    return results;
+}
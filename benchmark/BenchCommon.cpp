@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BenchCommon.h"
+#include "ClockDebug.h"
+
+#include <QtAlgorithms>
+
+#ifdef __GLIBC__
+#  include <stdlib.h>
+#  define BENCH_ALLOC_SUPPORTED
+#endif
+
+BenchOptions::BenchOptions() :
+    iSizesSet(false),
+    iMaxIterations(1000),
+    iMinIterations(5),
+    iTimeBudgetMs(500),
+    iGoldenDir("golden"),
+    iUpdateGolden(false)
+{
+    // From the smallest cover to the wall display
+    iSizes << 86 << 128 << 172 << 256 << 400 << 540 << 1080 << 2048 << 4096;
+    iStyles << ClockRenderer::SWISS_RAILROAD << ClockRenderer::HELSINKI_METRO
+        << ClockRenderer::DEUTSCHE_BAHN;
+    iRenderPaths << "raster" << "scenegraph";
+}
+
+QList<ClockRenderer*>
+benchRenderers(
+    const BenchOptions& aOptions)
+{
+    QList<ClockRenderer*> renderers;
+    for (int i = 0; i < aOptions.iStyles.count(); i++) {
+        ClockRenderer* renderer = ClockRenderer::find(aOptions.iStyles.at(i));
+        if (renderer) {
+            renderers.append(renderer);
+        } else {
+            HWARN("Unknown style" << aOptions.iStyles.at(i));
+        }
+    }
+    return renderers;
+}
+
+QJsonObject
+benchFailure(
+    const QString& aError)
+{
+    QJsonObject result;
+    result.insert("error", aError);
+    result.insert("status", QString("FAIL"));
+    return result;
+}
+
+// ==========================================================================
+// BenchSamples
+// ==========================================================================
+
+void
+BenchSamples::add(
+    qint64 aNanoseconds,
+    quint64 aBytes,
+    quint64 aAllocs)
+{
+    iTimes.append(aNanoseconds);
+    iBytes += aBytes;
+    iAllocs += aAllocs;
+}
+
+int
+BenchSamples::count() const
+{
+    return iTimes.count();
+}
+
+qint64
+BenchSamples::mean() const
+{
+    qint64 sum = 0;
+    const int n = iTimes.count();
+    for (int i = 0; i < n; i++) {
+        sum += iTimes.at(i);
+    }
+    return n ? (sum / n) : 0;
+}
+
+qint64
+BenchSamples::percentile(
+    int aPercent) const
+{
+    const int n = iTimes.count();
+    if (n > 0) {
+        QVector<qint64> sorted(iTimes);
+        qSort(sorted);
+        // Nearest-rank method
+        const int rank = (aPercent * n + 99) / 100;
+        return sorted.at(qBound(0, rank - 1, n - 1));
+    }
+    return 0;
+}
+
+QJsonObject
+BenchSamples::toJson() const
+{
+    const int n = iTimes.count();
+    QJsonObject obj;
+    obj.insert("iterations", n);
+    obj.insert("ns_per_frame", (double)mean());
+    obj.insert("p50_ns", (double)percentile(50));
+    obj.insert("p95_ns", (double)percentile(95));
+    obj.insert("max_ns", (double)percentile(100));
+    obj.insert("bytes_per_call", n ? ((double)iBytes / n) : 0.0);
+    obj.insert("allocs_per_call", n ? ((double)iAllocs / n) : 0.0);
+    return obj;
+}
+
+// ==========================================================================
+// BenchAlloc
+// ==========================================================================
+
+static thread_local bool benchAllocActive = false;
+static thread_local quint64 benchAllocBytes = 0;
+static thread_local quint64 benchAllocCount = 0;
+
+void
+BenchAlloc::start()
+{
+    benchAllocBytes = 0;
+    benchAllocCount = 0;
+    benchAllocActive = true;
+}
+
+void
+BenchAlloc::stop()
+{
+    benchAllocActive = false;
+}
+
+quint64
+BenchAlloc::bytes()
+{
+    return benchAllocBytes;
+}
+
+quint64
+BenchAlloc::count()
+{
+    return benchAllocCount;
+}
+
+#ifdef BENCH_ALLOC_SUPPORTED
+
+// Interpose the glibc allocator. operator new ends up here too.
+
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* __libc_calloc(size_t, size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+
+static inline void benchAllocRecord(size_t aSize)
+{
+    if (benchAllocActive) {
+        benchAllocBytes += aSize;
+        benchAllocCount++;
+    }
+}
+
+extern "C" void* malloc(size_t aSize)
+{
+    benchAllocRecord(aSize);
+    return __libc_malloc(aSize);
+}
+
+extern "C" void* calloc(size_t aCount, size_t aSize)
+{
+    benchAllocRecord(aCount * aSize);
+    return __libc_calloc(aCount, aSize);
+}
+
+extern "C" void* realloc(void* aPtr, size_t aSize)
+{
+    benchAllocRecord(aSize);
+    return __libc_realloc(aPtr, aSize);
+}
+
+#endif // BENCH_ALLOC_SUPPORTED
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include "ClockRenderer.h"
+#include "ClockTimeSource.h"
+
+#include <QList>
+#include <QVector>
+#include <QElapsedTimer>
+#include <QString>
+#include <QJsonArray>
+#include <QJsonObject>
+
+// Benchmark time starts at 10:08:00 and advances by one display-on
+// update interval per iteration, so that every iteration paints the
+// hands at a slightly different angle (and occasionally crosses the
+// minute boundary)
+#define BENCH_START_TIME QTime(10, 8, 0)
+#define BENCH_TIME_STEP_MS QUICK_CLOCK_MIN_UPDATE_INTERVAL
+
+class BenchOptions {
+public:
+    BenchOptions();
+
+    QList<int> iSizes;
+    bool iSizesSet;
+    QStringList iStyles;
+    QStringList iRenderPaths;
+    int iMaxIterations;
+    int iMinIterations;
+    int iTimeBudgetMs;
+    QString iGoldenDir;
+    bool iUpdateGolden;
+};
+
+// Virtual clock for QuickClock, set before each frame. Must be installed
+// with ClockTimeSource::setSharedInstance() before the clock is created.
+class BenchTimeSource : public ClockTimeSource {
+public:
+    void setTime(const QTime& aTime) { iTime = aTime; }
+    QTime currentTime() const Q_DECL_OVERRIDE { return iTime; }
+    void refresh() Q_DECL_OVERRIDE {}
+
+private:
+    QTime iTime;
+};
+
+// Collects per-call samples and turns them into statistics
+class BenchSamples {
+public:
+    void add(qint64 aNanoseconds, quint64 aBytes, quint64 aAllocs);
+    int count() const;
+    qint64 mean() const;
+    qint64 percentile(int aPercent) const;
+    QJsonObject toJson() const;
+
+private:
+    QVector<qint64> iTimes;
+    quint64 iBytes;
+    quint64 iAllocs;
+
+public:
+    BenchSamples() : iBytes(0), iAllocs(0) {}
+};
+
+// Counts heap allocations made by the calling thread between start()
+// and stop(). Only works with glibc, elsewhere the numbers are zero.
+class BenchAlloc {
+public:
+    static void start();
+    static void stop();
+    static quint64 bytes();
+    static quint64 count();
+};
+
+// Runs aCase(iteration) until either the time budget or the maximum
+// number of iterations is exhausted
+template <class C>
+BenchSamples benchRun(const BenchOptions& aOptions, C& aCase)
+{
+    BenchSamples samples;
+    QElapsedTimer total;
+
+    // Warm up
+    aCase(0);
+
+    total.start();
+    for (int i = 0; i < aOptions.iMaxIterations &&
+         (i < aOptions.iMinIterations ||
+          total.elapsed() < aOptions.iTimeBudgetMs); i++) {
+        QElapsedTimer timer;
+        BenchAlloc::start();
+        timer.start();
+        aCase(i);
+        const qint64 ns = timer.nsecsElapsed();
+        BenchAlloc::stop();
+        samples.add(ns, BenchAlloc::bytes(), BenchAlloc::count());
+    }
+    return samples;
+}
+
+// Renderers under test
+QList<ClockRenderer*> benchRenderers(const BenchOptions& aOptions);
+
+// Result which fails the run (clockbench exits with status 2)
+QJsonObject benchFailure(const QString& aError);
+
+// Individual benchmarks
+QJsonArray benchAccuracy(const BenchOptions& aOptions);
+QJsonArray benchAntialias(const BenchOptions& aOptions);
+QJsonArray benchDial(const BenchOptions& aOptions);
+QJsonArray benchGolden(const BenchOptions& aOptions);
+QJsonArray benchGeometry(const BenchOptions& aOptions);
+QJsonArray benchLayers(const BenchOptions& aOptions);
+QJsonArray benchMotion(const BenchOptions& aOptions);
+QJsonArray benchParity(const BenchOptions& aOptions);
+QJsonArray benchRaster(const BenchOptions& aOptions);
+QJsonArray benchSceneGraph(const BenchOptions& aOptions);
+QJsonArray benchSuspend(const BenchOptions& aOptions);
+QJsonArray benchTessellation(const BenchOptions& aOptions);
+
+#endif // BENCH_COMMON_H
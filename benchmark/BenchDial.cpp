@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BenchCommon.h"
+
+#include "ClockDialTicks.h"
+#include "ClockGeometryBuilder.h"
+
+#include <stdio.h>
+
+enum DialOp {
+    DialLoop,
+    DialPath,
+    DialGenerate,
+    DialGeometry,
+    DialOpCount
+};
+
+static const char* const DIAL_OP_NAME[DialOpCount] = {
+    "loop",
+    "path",
+    "generate",
+    "geometry"
+};
+
+// Tick marks the way paintDialPlate used to paint them, rotating the
+// painter and filling one rectangle per tick
+static void
+paintTicksLoop(
+    QPainter* aPainter,
+    ClockRenderer* aRenderer,
+    const QSize& aSize,
+    const QColor& aColor)
+{
+    const QBrush brush(aColor);
+    aPainter->save();
+    aPainter->translate(aSize.width()/2.0, aSize.height()/2.0);
+    for (int i = 0; i < ClockDialTicks::TICK_COUNT; i++) {
+        aPainter->fillRect(aRenderer->tickMarkRect(aSize, i), brush);
+        aPainter->rotate(6.0);
+    }
+    aPainter->restore();
+}
+
+// Generates or paints all 60 tick marks
+class DialCase {
+public:
+    DialCase(ClockRenderer* aRenderer, ClockTheme* aTheme,
+        const QSize& aSize, DialOp aOp) :
+        iRenderer(aRenderer),
+        iColor(aTheme->iHourMinHandColor),
+        iSize(aSize),
+        iOp(aOp),
+        iTicks(aRenderer->dialTicks(aSize)),
+        iImage(aSize, QImage::Format_ARGB32_Premultiplied)
+        { iImage.fill(Qt::transparent); }
+
+    void operator()(int aIteration);
+
+private:
+    ClockRenderer* iRenderer;
+    QColor iColor;
+    QSize iSize;
+    DialOp iOp;
+    QSharedPointer<const ClockDialTicks> iTicks;
+    QImage iImage;
+};
+
+void
+DialCase::operator()(
+    int)
+{
+    if (iOp == DialGenerate) {
+        // Bypasses the cache, that's what happens once per size
+        ClockDialTicks ticks(iSize, iRenderer);
+    } else if (iOp == DialGeometry) {
+        ClockGeometryBuilder builder(1);
+        iTicks->addTo(&builder, iColor);
+        delete builder.geometry();
+    } else {
+        QPainter painter(&iImage);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setRenderHint(QPainter::HighQualityAntialiasing);
+        if (iOp == DialLoop) {
+            paintTicksLoop(&painter, iRenderer, iSize, iColor);
+        } else {
+            iTicks->paint(&painter, iColor);
+        }
+    }
+}
+
+// Maximum per-channel difference between the ticks painted one by one
+// and all at once
+static int
+dialMaxDiff(
+    ClockRenderer* aRenderer,
+    const QSize& aSize,
+    const QColor& aColor)
+{
+    QImage image1(aSize, QImage::Format_ARGB32_Premultiplied);
+    QImage image2(aSize, QImage::Format_ARGB32_Premultiplied);
+    image1.fill(Qt::transparent);
+    image2.fill(Qt::transparent);
+
+    QPainter painter1(&image1);
+    painter1.setRenderHint(QPainter::Antialiasing);
+    paintTicksLoop(&painter1, aRenderer, aSize, aColor);
+    painter1.end();
+
+    QPainter painter2(&image2);
+    painter2.setRenderHint(QPainter::Antialiasing);
+    aRenderer->dialTicks(aSize)->paint(&painter2, aColor);
+    painter2.end();
+
+    int maxDiff = 0;
+    for (int y = 0; y < aSize.height(); y++) {
+        const uchar* line1 = image1.constScanLine(y);
+        const uchar* line2 = image2.constScanLine(y);
+        for (int x = 0; x < aSize.width() * 4; x++) {
+            maxDiff = qMax(maxDiff, qAbs(line1[x] - line2[x]));
+        }
+    }
+    return maxDiff;
+}
+
+// Tick marks painted one by one (the old way) and all at once, plus the
+// cost of generating them (once per size) and turning them into the scene
+// graph geometry. The large sizes are there for the wall displays.
+QJsonArray
+benchDial(
+    const BenchOptions& aOptions)
+{
+    QJsonArray results;
+    ClockTheme* theme = ClockTheme::defaultTheme();
+    QList<ClockRenderer*> renderers = benchRenderers(aOptions);
+
+    printf("%-14s %5s %-10s %12s %12s %10s %8s\n", "style", "size", "call",
+        "us/call", "p95 us", "bytes/call", "max diff");
+    for (int i = 0; i < renderers.count(); i++) {
+        ClockRenderer* renderer = renderers.at(i);
+        for (int j = 0; j < aOptions.iSizes.count(); j++) {
+            const int d = aOptions.iSizes.at(j);
+            const QSize size(d, d);
+            const int maxDiff = dialMaxDiff(renderer, size,
+                theme->iHourMinHandColor);
+            for (int op = 0; op < DialOpCount; op++) {
+                DialCase dialCase(renderer, theme, size, (DialOp)op);
+                BenchSamples samples(benchRun(aOptions, dialCase));
+                QJsonObject result(samples.toJson());
+                result.insert("style", renderer->id());
+                result.insert("size", d);
+                result.insert("call", QString(DIAL_OP_NAME[op]));
+                result.insert("max_diff", maxDiff);
+                results.append(result);
+                printf("%-14s %5d %-10s %12.1f %12.1f %10.0f %8d\n",
+                    qPrintable(renderer->id()), d, DIAL_OP_NAME[op],
+                    samples.mean()/1000.0, samples.percentile(95)/1000.0,
+                    result.value("bytes_per_call").toDouble(), maxDiff);
+                fflush(stdout);
+            }
+        }
+    }
+    return results;
+}
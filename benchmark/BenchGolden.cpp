@@ -0,0 +1,384 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BenchCommon.h"
+#include "BenchQuickHost.h"
+#include "QuickClock.h"
+
+#include <QDir>
+#include <QPainter>
+#include <QElapsedTimer>
+#include <QScopedPointer>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+
+#include <stdio.h>
+
+// The simulated day is stepped through in slightly more than a minute
+// per frame, so that the second hand visits different positions
+#define GOLDEN_DAY_MS (86400000)
+#define GOLDEN_STEP_MS (61370)
+
+// GL implementations don't all rasterize exactly the same way
+#define GOLDEN_TOLERANCE (2)
+
+#define GOLDEN_DEFAULT_SIZES (QList<int>() << 128 << 400)
+
+// Frames compared against the golden images. The hour and minute hands
+// moving at the top of the minute, the Swiss second hand pausing at the
+// top, midnight and the usual 10:08.
+static const char* const GOLDEN_TIMES[] = {
+    "00:00:00.000",
+    "03:15:30.500",
+    "09:59:59.900",
+    "10:08:00.000",
+    "12:00:00.250",
+    "15:45:58.800",
+    "18:30:15.125",
+    "23:59:59.999"
+};
+
+enum GoldenRender {
+    GoldenRaster,
+    GoldenSceneGraph,
+    GoldenRenderCount
+};
+
+static const char* const GOLDEN_RENDER_NAME[GoldenRenderCount] = {
+    "raster",
+    "scenegraph"
+};
+
+// Renders QuickClock at the given time, one way or another
+class GoldenHost {
+public:
+    virtual ~GoldenHost() {}
+    virtual bool isValid() const = 0;
+    virtual QImage render(const QTime& aTime, qint64* aFrameNs) = 0;
+};
+
+// The raster path without a window, QuickClock::paint() is called
+// directly. That's pure QPainter, the images don't depend on the GL
+// implementation and can be compared anywhere.
+class GoldenRasterHost : public GoldenHost {
+public:
+    GoldenRasterHost(const QSize& aSize, const QString& aStyle,
+        bool aInverted);
+    ~GoldenRasterHost();
+
+    bool isValid() const Q_DECL_OVERRIDE;
+    QImage render(const QTime& aTime, qint64* aFrameNs) Q_DECL_OVERRIDE;
+
+private:
+    QSharedPointer<BenchTimeSource> iTimeSource;
+    QuickClock* iClock;
+};
+
+GoldenRasterHost::GoldenRasterHost(
+    const QSize& aSize,
+    const QString& aStyle,
+    bool aInverted) :
+    iTimeSource(new BenchTimeSource)
+{
+    // The clock picks up the shared instance when it's created
+    ClockTimeSource::setSharedInstance(iTimeSource);
+    iClock = new QuickClock;
+    iClock->setRenderType(ClockSettings::RenderQuality);
+    iClock->setStyle(aStyle);
+    iClock->setInvertColors(aInverted);
+    iClock->setSize(aSize);
+    QCoreApplication::processEvents();
+}
+
+GoldenRasterHost::~GoldenRasterHost()
+{
+    delete iClock;
+}
+
+bool
+GoldenRasterHost::isValid() const
+{
+    return true;
+}
+
+QImage
+GoldenRasterHost::render(
+    const QTime& aTime,
+    qint64* aFrameNs)
+{
+    QElapsedTimer timer;
+    QImage image(iClock->size().toSize(),
+        QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    iTimeSource->setTime(aTime);
+    timer.start();
+    QPainter painter(&image);
+    // QQuickPaintedItem::paint() is public, QuickClock::paint() is not
+    static_cast<QQuickPaintedItem*>(iClock)->paint(&painter);
+    painter.end();
+    *aFrameNs = timer.nsecsElapsed();
+    return image;
+}
+
+// The scene graph path, offscreen window and OpenGL
+class GoldenSceneGraphHost : public GoldenHost {
+public:
+    GoldenSceneGraphHost(const QSize& aSize, const QString& aStyle,
+        bool aInverted) : iHost(aSize, aStyle, ClockSettings::RenderSpeed,
+        aInverted) {}
+
+    bool isValid() const Q_DECL_OVERRIDE { return iHost.isValid(); }
+    QImage render(const QTime& aTime, qint64* aFrameNs) Q_DECL_OVERRIDE;
+
+private:
+    BenchClockHost iHost;
+};
+
+QImage
+GoldenSceneGraphHost::render(
+    const QTime& aTime,
+    qint64* aFrameNs)
+{
+    iHost.setTime(aTime);
+    iHost.invalidate(false);
+    return iHost.render(aFrameNs);
+}
+
+static QString
+goldenChecksum(
+    const QImage& aImage)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    for (int y = 0; y < aImage.height(); y++) {
+        hash.addData((const char*)aImage.constScanLine(y),
+            aImage.width() * 4);
+    }
+    return QString::fromLatin1(hash.result().toHex().left(16));
+}
+
+// Maximum per-channel difference and the number of pixels exceeding
+// the tolerance
+static int
+goldenDiff(
+    const QImage& aImage,
+    const QImage& aGolden,
+    int* aPixels)
+{
+    int maxDiff = 0;
+    *aPixels = 0;
+    for (int y = 0; y < aImage.height(); y++) {
+        const uchar* line1 = aImage.constScanLine(y);
+        const uchar* line2 = aGolden.constScanLine(y);
+        for (int x = 0; x < aImage.width(); x++) {
+            int diff = 0;
+            for (int c = 0; c < 4; c++) {
+                diff = qMax(diff, qAbs(line1[4*x + c] - line2[4*x + c]));
+            }
+            if (diff > GOLDEN_TOLERANCE) (*aPixels)++;
+            maxDiff = qMax(maxDiff, diff);
+        }
+    }
+    return maxDiff;
+}
+
+// Steps QuickClock through a simulated day with the virtual clock, for
+// each style, size, theme and render path, and compares the frames at
+// GOLDEN_TIMES against the golden images (or writes them with --update).
+// A missing golden image or a render path which can't be initialized
+// fails the run.
+// Render time is recorded for every frame, so that a change in pixels
+// and a change in performance show up together.
+QJsonArray
+benchGolden(
+    const BenchOptions& aOptions)
+{
+    QJsonArray results;
+    const QList<int> sizes(aOptions.iSizesSet ? aOptions.iSizes :
+        GOLDEN_DEFAULT_SIZES);
+    const QDir dir(aOptions.iGoldenDir);
+    QList<QTime> goldenTimes;
+    int failures = 0;
+
+    for (uint i = 0; i < sizeof(GOLDEN_TIMES)/sizeof(GOLDEN_TIMES[0]); i++) {
+        goldenTimes.append(QTime::fromString(GOLDEN_TIMES[i], "hh:mm:ss.zzz"));
+    }
+    if (aOptions.iUpdateGolden && !dir.mkpath(".")) {
+        fprintf(stderr, "Failed to create %s\n", qPrintable(dir.path()));
+        results.append(benchFailure("mkdir"));
+        return results;
+    }
+
+    printf("%-14s %5s %-8s %-10s %-12s %-16s %8s %8s %-8s\n", "style", "size",
+        "theme", "render", "time", "checksum", "frame us", "max diff",
+        "status");
+    for (int i = 0; i < aOptions.iStyles.count(); i++) {
+        const QString style(aOptions.iStyles.at(i));
+        for (int j = 0; j < sizes.count(); j++) {
+            const int d = sizes.at(j);
+            for (int inverted = 0; inverted < 2; inverted++) {
+                const char* theme = inverted ? "inverted" : "default";
+                for (int r = 0; r < GoldenRenderCount; r++) {
+                    const QString render(GOLDEN_RENDER_NAME[r]);
+                    if (!aOptions.iRenderPaths.contains(render)) {
+                        continue;
+                    }
+                    QScopedPointer<GoldenHost> host((r == GoldenRaster) ?
+                        (GoldenHost*) new GoldenRasterHost(QSize(d, d), style,
+                        inverted) : (GoldenHost*) new GoldenSceneGraphHost(
+                        QSize(d, d), style, inverted));
+                    if (!host->isValid()) {
+                        // Nothing to compare is a failure
+                        fprintf(stderr, "Failed to initialize OpenGL\n");
+                        QJsonObject result(benchFailure("OpenGL"));
+                        result.insert("style", style);
+                        result.insert("size", d);
+                        result.insert("theme", QString(theme));
+                        result.insert("render", render);
+                        results.append(result);
+                        failures++;
+                        continue;
+                    }
+
+                    // The golden frames are rendered in the middle of the
+                    // day, i.e. after whatever the previous frames have
+                    // left behind (cached layers and such)
+                    BenchSamples day;
+                    int next = 0;
+                    for (int ms = 0; ms < GOLDEN_DAY_MS ||
+                         next < goldenTimes.count();) {
+                        QTime t;
+                        const bool golden = (next < goldenTimes.count() &&
+                            goldenTimes.at(next).msecsSinceStartOfDay() <= ms);
+                        if (golden) {
+                            t = goldenTimes.at(next++);
+                        } else {
+                            t = QTime::fromMSecsSinceStartOfDay(ms);
+                            ms += GOLDEN_STEP_MS;
+                            if (goldenTimes.contains(t)) {
+                                // Has just been rendered and compared
+                                continue;
+                            }
+                        }
+                        qint64 ns;
+                        const QImage image(host->render(t, &ns));
+                        day.add(ns, 0, 0);
+                        if (!golden) {
+                            continue;
+                        }
+
+                        const QString timeString(t.toString("hhmmsszzz"));
+                        const QString file(dir.filePath(QString(
+                            "%1-%2-%3-%4-%5.png").arg(style).arg(d).
+                            arg(theme).arg(GOLDEN_RENDER_NAME[r]).
+                            arg(timeString)));
+                        const QString checksum(goldenChecksum(image));
+                        QString status;
+                        int maxDiff = 0, pixels = 0;
+                        if (aOptions.iUpdateGolden) {
+                            if (image.save(file)) {
+                                status = "updated";
+                            } else {
+                                status = "FAIL";
+                                failures++;
+                            }
+                        } else {
+                            QImage expected(file);
+                            if (expected.isNull() ||
+                                expected.size() != image.size()) {
+                                // A missing golden image is a failure too,
+                                // otherwise a clean checkout always passes
+                                status = "FAIL";
+                                failures++;
+                            } else {
+                                expected = expected.convertToFormat(
+                                    QImage::Format_ARGB32_Premultiplied);
+                                maxDiff = goldenDiff(image, expected, &pixels);
+                                if (pixels) {
+                                    status = "FAIL";
+                                    failures++;
+                                } else {
+                                    status = "ok";
+                                }
+                            }
+                        }
+
+                        QJsonObject result;
+                        result.insert("style", style);
+                        result.insert("size", d);
+                        result.insert("theme", QString(theme));
+                        result.insert("render", render);
+                        result.insert("time", t.toString("hh:mm:ss.zzz"));
+                        result.insert("checksum", checksum);
+                        result.insert("frame_ns", ns);
+                        result.insert("max_diff", maxDiff);
+                        result.insert("diff_pixels", pixels);
+                        result.insert("status", status);
+                        results.append(result);
+                        printf("%-14s %5d %-8s %-10s %-12s %-16s %8.1f %8d "
+                            "%-8s\n", qPrintable(style), d, theme,
+                            GOLDEN_RENDER_NAME[r],
+                            qPrintable(t.toString("hh:mm:ss.zzz")),
+                            qPrintable(checksum), ns/1000.0, maxDiff,
+                            qPrintable(status));
+                        fflush(stdout);
+                    }
+
+                    QJsonObject result(day.toJson());
+                    result.insert("style", style);
+                    result.insert("size", d);
+                    result.insert("theme", QString(theme));
+                    result.insert("render", render);
+                    result.insert("time", QString("day"));
+                    results.append(result);
+                    printf("%-14s %5d %-8s %-10s %-12s %-16s %8.1f %8s "
+                        "p95 %.1f us, %d frames\n", qPrintable(style), d,
+                        theme, GOLDEN_RENDER_NAME[r], "day", "",
+                        day.mean()/1000.0, "", day.percentile(95)/1000.0,
+                        day.count());
+                    fflush(stdout);
+                }
+            }
+        }
+    }
+    ClockTimeSource::setSharedInstance(QSharedPointer<ClockTimeSource>());
+    if (failures) {
+        printf("%d frame(s) differ from the golden images or couldn't be "
+            "compared\n", failures);
+    }
+    return results;
+}
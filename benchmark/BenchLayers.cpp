@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BenchCommon.h"
+#include "ClockHourMinLayer.h"
+
+#include <stdio.h>
+
+#define LAYER_SIZE (256)
+#define LAYER_SIMULATED_MS (60*60*1000)
+
+// Simulates an hour of raster rendering at the display-on frame rate and
+// counts how many times the hour/minute layer gets redrawn. Apart from
+// the first frame, that should only happen at the top of each minute,
+// while the hour and minute hands are moving. The hands stand still at
+// the first frame of the minute and arrive one frame after the move is
+// over, so each minute takes ceil(move/step) redraws. Anything else is
+// a failure, too many redraws are wasted and too few leave the hands
+// behind.
+QJsonArray
+benchLayers(
+    const BenchOptions& aOptions)
+{
+    QJsonArray results;
+    const QSize size(LAYER_SIZE, LAYER_SIZE);
+    const int frames = LAYER_SIMULATED_MS / BENCH_TIME_STEP_MS;
+    const int minutes = LAYER_SIMULATED_MS / 60000;
+    ClockTheme* theme = ClockTheme::defaultTheme();
+    QList<ClockRenderer*> renderers = benchRenderers(aOptions);
+
+    QPixmap dial(size);
+    dial.fill(Qt::transparent);
+
+    printf("%-14s %8s %8s %8s %12s\n", "style", "frames", "updates",
+        "expected", "us/frame");
+    for (int i = 0; i < renderers.count(); i++) {
+        ClockRenderer* renderer = renderers.at(i);
+        const int moveMs = qMax(
+            renderer->motionProfile(ClockRenderer::NodeHour).moveTime(),
+            renderer->motionProfile(ClockRenderer::NodeMin).moveTime());
+        const int expected = 1 + minutes *
+            ((moveMs + BENCH_TIME_STEP_MS - 1) / BENCH_TIME_STEP_MS);
+        ClockHourMinLayer layer;
+        QElapsedTimer timer;
+
+        timer.start();
+        for (int f = 0; f < frames; f++) {
+            const QTime t(BENCH_START_TIME.addMSecs(f * BENCH_TIME_STEP_MS));
+            layer.update(renderer, theme, &dial, size, t);
+        }
+        const qint64 ns = timer.nsecsElapsed();
+        const int updates = layer.updateCount();
+
+        QJsonObject result;
+        result.insert("style", renderer->id());
+        result.insert("size", LAYER_SIZE);
+        result.insert("frames", frames);
+        result.insert("layer_updates", updates);
+        result.insert("layer_updates_expected", expected);
+        result.insert("ns_per_frame", (double)(ns / frames));
+        if (updates != expected) {
+            result.insert("status", QString("FAIL"));
+        }
+        results.append(result);
+        printf("%-14s %8d %8d %8d %12.1f%s\n", qPrintable(renderer->id()),
+            frames, updates, expected, ns / 1000.0 / frames,
+            (updates > expected) ? "  TOO MANY UPDATES" :
+            (updates < expected) ? "  TOO FEW UPDATES" : "");
+    }
+    return results;
+}
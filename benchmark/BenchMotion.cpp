@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BenchCommon.h"
+
+#include <qmath.h>
+
+#include <stdio.h>
+
+// Calls per iteration
+#define MOTION_CALLS (1000)
+
+// The angles are compared over this range, every MOTION_STEP_MS
+#define MOTION_START_MS (10*3600*1000)
+#define MOTION_END_MS (12*3600*1000)
+#define MOTION_STEP_MS (3)
+
+// The legacy tick motion moved in whole seconds of the minute, i.e. in
+// steps of 0.1 degree of the minute hand, the tables move smoothly
+#define MOTION_MAX_DIFF (0.15)
+
+static const char* const MOTION_NODE_NAME[] = {
+    "hour",
+    "min",
+    "sec"
+};
+
+// Hand angles the way nodeAngle used to calculate them, before the
+// motion profiles
+static qreal
+motionLegacyAngle(
+    ClockRenderer* aRenderer,
+    ClockRenderer::NodeType aType,
+    const QTime& aTime)
+{
+    const bool swiss = (aRenderer->id() == ClockRenderer::SWISS_RAILROAD);
+    if (aType == ClockRenderer::NodeSec) {
+        if (swiss) {
+            const int msec = aTime.second() * 1000 + aTime.msec();
+            return (msec <= 58500) ? ((360.0 * msec)/58500) : 0.0;
+        } else {
+            return 6 * (aTime.second() + aTime.msec()/1000.0);
+        }
+    } else if (swiss && aType == ClockRenderer::NodeMin &&
+        aTime.second() == 0) {
+        const qreal x = aTime.msec()/222.0;
+        return 6*(aTime.minute() - qExp(-1.5 * x) * qCos(2 * M_PI * x));
+    } else {
+        QTime t;
+        if (aTime.second() == 0) {
+            QTime t1 = aTime.addSecs(-1);
+            t = QTime(t1.hour(), t1.minute(), 60*t1.msec()/1000);
+        } else {
+            t = QTime(aTime.hour(), aTime.minute(), 0);
+        }
+        if (aType == ClockRenderer::NodeHour) {
+            return 30*(t.hour() + (t.minute() + t.second()/60.0)/60);
+        } else {
+            return 6*(t.minute() + (t.second() + t.msec()/1000.0)/60);
+        }
+    }
+}
+
+// Evaluates the angle for MOTION_CALLS consecutive frames of the first
+// second of a minute, where the hands are moving
+class MotionCase {
+public:
+    MotionCase(ClockRenderer* aRenderer, ClockRenderer::NodeType aType,
+        bool aLegacy) :
+        iRenderer(aRenderer), iType(aType), iLegacy(aLegacy), iSum(0) {}
+
+    void operator()(int aIteration) {
+        const QTime start(BENCH_START_TIME.addSecs(aIteration * 60));
+        for (int i = 0; i < MOTION_CALLS; i++) {
+            const QTime t(start.addMSecs(i));
+            iSum += iLegacy ? motionLegacyAngle(iRenderer, iType, t) :
+                iRenderer->nodeAngle(iType, t);
+        }
+    }
+
+    ClockRenderer* iRenderer;
+    ClockRenderer::NodeType iType;
+    bool iLegacy;
+    qreal iSum; // Keeps the calls from being optimized out
+};
+
+// Largest difference between the legacy and the profile angles
+static qreal
+motionMaxDiff(
+    ClockRenderer* aRenderer,
+    ClockRenderer::NodeType aType)
+{
+    qreal maxDiff = 0;
+    for (int ms = MOTION_START_MS; ms < MOTION_END_MS; ms += MOTION_STEP_MS) {
+        const QTime t(QTime::fromMSecsSinceStartOfDay(ms));
+        qreal diff = aRenderer->nodeAngle(aType, t) -
+            motionLegacyAngle(aRenderer, aType, t);
+        diff -= 360 * qRound(diff / 360);
+        maxDiff = qMax(maxDiff, qAbs(diff));
+    }
+    return maxDiff;
+}
+
+// Checks that the precomputed motion profiles move the hands the way the
+// old formulas did and compares how long it takes
+QJsonArray
+benchMotion(
+    const BenchOptions& aOptions)
+{
+    QJsonArray results;
+    QList<ClockRenderer*> renderers = benchRenderers(aOptions);
+
+    printf("%-14s %-5s %12s %12s %10s\n", "style", "hand", "legacy ns",
+        "profile ns", "max diff");
+    for (int i = 0; i < renderers.count(); i++) {
+        ClockRenderer* renderer = renderers.at(i);
+        for (int n = ClockRenderer::NodeHour; n <= ClockRenderer::NodeSec;
+             n++) {
+            const ClockRenderer::NodeType type = (ClockRenderer::NodeType)n;
+            MotionCase legacyCase(renderer, type, true);
+            MotionCase profileCase(renderer, type, false);
+            BenchSamples legacy(benchRun(aOptions, legacyCase));
+            BenchSamples profile(benchRun(aOptions, profileCase));
+            const qreal maxDiff = motionMaxDiff(renderer, type);
+            QJsonObject result;
+            result.insert("style", renderer->id());
+            result.insert("hand", QString(MOTION_NODE_NAME[n]));
+            result.insert("legacy", legacy.toJson());
+            result.insert("profile", profile.toJson());
+            result.insert("max_diff", maxDiff);
+            if (maxDiff > MOTION_MAX_DIFF) {
+                result.insert("status", QString("FAIL"));
+            }
+            results.append(result);
+            printf("%-14s %-5s %12.1f %12.1f %10.5f%s\n",
+                qPrintable(renderer->id()), MOTION_NODE_NAME[n],
+                double(legacy.mean()) / MOTION_CALLS,
+                double(profile.mean()) / MOTION_CALLS, maxDiff,
+                (maxDiff > MOTION_MAX_DIFF) ? "  DIFFERENT" : "");
+            fflush(stdout);
+        }
+    }
+    return results;
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BenchCommon.h"
+#include "BenchQuickHost.h"
+#include "QuickClock.h"
+#include "QuickClockLayer.h"
+
+#include <stdio.h>
+
+// Hands at odd angles, so that any offset shows up
+#define PARITY_TIME QTime(10, 8, 12, 500)
+
+// Antialiasing differs between the two paths (coverage vs feathered
+// edges), smaller differences are not counted
+#define PARITY_THRESHOLD (48)
+
+#define PARITY_DEFAULT_SIZES (QList<int>() << 128 << 400)
+
+// Each stage adds layers on top of the previous one
+enum ParityStage {
+    ParityDial,
+    ParityHourMin,
+    ParitySec,
+    ParityStageCount
+};
+
+static const char* const PARITY_STAGE_NAME[ParityStageCount] = {
+    "dial",
+    "hourMin",
+    "sec"
+};
+
+// Renders the optimized (scene graph) clock up to the given stage. The
+// layers are nested, hiding one hides everything above it too.
+static QImage
+paritySceneGraph(
+    BenchClockHost* aHost,
+    ParityStage aStage)
+{
+    qint64 ns;
+    const QList<QuickClockLayer*> layers(aHost->layers());
+    for (int i = 0; i < layers.count(); i++) {
+        QuickClockLayer* layer = layers.at(i);
+        switch (layer->type()) {
+        case ClockRenderer::NodeHour:
+            layer->setVisible(aStage >= ParityHourMin);
+            break;
+        case ClockRenderer::NodeSec:
+            layer->setVisible(aStage >= ParitySec);
+            break;
+        default:
+            break;
+        }
+    }
+    aHost->invalidate(false);
+    return aHost->render(&ns);
+}
+
+// Paints the same stage the way QuickClock::paint() does it
+static QImage
+parityRaster(
+    ClockRenderer* aRenderer,
+    const QSize& aSize,
+    ParityStage aStage)
+{
+    ClockTheme* theme = ClockTheme::defaultTheme();
+    QImage image(aSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setRenderHint(QPainter::HighQualityAntialiasing);
+    aRenderer->paintDialPlate(&painter, aSize, theme, true);
+    if (aStage >= ParityHourMin) {
+        aRenderer->paintHourMinHands(&painter, aSize, PARITY_TIME, theme);
+    }
+    if (aStage >= ParitySec) {
+        aRenderer->paintSecHand(&painter, aSize, PARITY_TIME, theme);
+    }
+    painter.end();
+    return image;
+}
+
+struct ParityDiff {
+    int iMax;
+    int iPixels;
+    double iMean;
+    QRect iBounds;
+};
+
+static ParityDiff
+parityDiff(
+    const QImage& aImage1,
+    const QImage& aImage2)
+{
+    ParityDiff diff;
+    qint64 sum = 0;
+    diff.iMax = 0;
+    diff.iPixels = 0;
+    for (int y = 0; y < aImage1.height(); y++) {
+        const uchar* line1 = aImage1.constScanLine(y);
+        const uchar* line2 = aImage2.constScanLine(y);
+        for (int x = 0; x < aImage1.width(); x++) {
+            int d = 0;
+            for (int c = 0; c < 4; c++) {
+                d = qMax(d, qAbs(line1[4*x + c] - line2[4*x + c]));
+            }
+            sum += d;
+            diff.iMax = qMax(diff.iMax, d);
+            if (d > PARITY_THRESHOLD) {
+                diff.iPixels++;
+                diff.iBounds |= QRect(x, y, 1, 1);
+            }
+        }
+    }
+    diff.iMean = double(sum) / (aImage1.width() * aImage1.height());
+    return diff;
+}
+
+// Renders each style with the raster painter functions and with the
+// scene graph nodes at the same time and size, and reports per-pixel
+// differences. Square and portrait (non-square) items are compared,
+// stage by stage, so that a drift can be pinned to the layer. Pixels
+// differing by more than PARITY_THRESHOLD in any channel are counted,
+// the box column is their bounding rectangle.
+QJsonArray
+benchParity(
+    const BenchOptions& aOptions)
+{
+    QJsonArray results;
+    const QList<int> sizes(aOptions.iSizesSet ? aOptions.iSizes :
+        PARITY_DEFAULT_SIZES);
+
+    printf("%-14s %-10s %-8s %8s %8s %8s  %s\n", "style", "size", "stage",
+        "mean", "max", "pixels", "box");
+    for (int i = 0; i < aOptions.iStyles.count(); i++) {
+        const QString style(aOptions.iStyles.at(i));
+        ClockRenderer* renderer = ClockRenderer::find(style);
+        if (!renderer) {
+            HWARN("Unknown style" << style);
+            continue;
+        }
+        for (int j = 0; j < sizes.count(); j++) {
+            const int d = sizes.at(j) & ~1;
+            for (int portrait = 0; portrait < 2; portrait++) {
+                const QSize size(d, portrait ? ((d * 5 / 4) & ~1) : d);
+                BenchClockHost host(size, style, ClockSettings::RenderSpeed);
+                if (!host.isValid()) {
+                    // Nothing to compare is a failure
+                    fprintf(stderr, "Failed to initialize OpenGL\n");
+                    results.append(benchFailure("OpenGL"));
+                    return results;
+                }
+                host.setTime(PARITY_TIME);
+                const QString sizeString(QString("%1x%2").arg(size.width()).
+                    arg(size.height()));
+                for (int s = 0; s < ParityStageCount; s++) {
+                    const ParityStage stage = (ParityStage)s;
+                    const ParityDiff diff(parityDiff(
+                        paritySceneGraph(&host, stage),
+                        parityRaster(renderer, size, stage)));
+                    QJsonObject result;
+                    result.insert("style", style);
+                    result.insert("width", size.width());
+                    result.insert("height", size.height());
+                    result.insert("stage", QString(PARITY_STAGE_NAME[s]));
+                    result.insert("mean_diff", diff.iMean);
+                    result.insert("max_diff", diff.iMax);
+                    result.insert("diff_pixels", diff.iPixels);
+                    if (diff.iPixels) {
+                        QJsonArray box;
+                        box << diff.iBounds.x() << diff.iBounds.y() <<
+                            diff.iBounds.width() << diff.iBounds.height();
+                        result.insert("box", box);
+                    }
+                    results.append(result);
+                    printf("%-14s %-10s %-8s %8.3f %8d %8d  ",
+                        qPrintable(style), qPrintable(sizeString),
+                        PARITY_STAGE_NAME[s], diff.iMean, diff.iMax,
+                        diff.iPixels);
+                    if (diff.iPixels) {
+                        printf("%dx%d+%d+%d\n", diff.iBounds.width(),
+                            diff.iBounds.height(), diff.iBounds.x(),
+                            diff.iBounds.y());
+                    } else {
+                        printf("-\n");
+                    }
+                    fflush(stdout);
+                }
+            }
+        }
+    }
+    return results;
+}
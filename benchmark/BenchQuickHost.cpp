@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BenchQuickHost.h"
+#include "QuickClock.h"
+#include "QuickClockLayer.h"
+
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QElapsedTimer>
+#include <QOpenGLFunctions>
+#include <QOpenGLFramebufferObject>
+#include <QSurfaceFormat>
+#include <QCoreApplication>
+
+#include <private/qquickitem_p.h>
+
+BenchQuickHost::BenchQuickHost(
+    const QSize& aSize,
+    int aSamples,
+    int aContextSamples) :
+    iWindow(new QQuickWindow(&iRenderControl)),
+    iFbo(NULL),
+    iResolveFbo(NULL)
+{
+    QSurfaceFormat contextFormat(QSurfaceFormat::defaultFormat());
+    contextFormat.setSamples(aContextSamples);
+    iContext.setFormat(contextFormat);
+    if (iContext.create()) {
+        iSurface.setFormat(iContext.format());
+        iSurface.create();
+        if (iContext.makeCurrent(&iSurface)) {
+            QOpenGLFramebufferObjectFormat format;
+            format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+            format.setSamples(aSamples);
+            iRenderControl.initialize(&iContext);
+            iFbo = new QOpenGLFramebufferObject(aSize, format);
+            if (iFbo->format().samples() > 1) {
+                iResolveFbo = new QOpenGLFramebufferObject(aSize);
+            }
+            iWindow->setRenderTarget(iFbo);
+            iWindow->setGeometry(0, 0, aSize.width(), aSize.height());
+            iWindow->contentItem()->setSize(aSize);
+        }
+    }
+}
+
+BenchQuickHost::~BenchQuickHost()
+{
+    if (iFbo) {
+        iContext.makeCurrent(&iSurface);
+        delete iWindow;
+        delete iResolveFbo;
+        delete iFbo;
+        iContext.doneCurrent();
+    } else {
+        delete iWindow;
+    }
+}
+
+bool
+BenchQuickHost::isValid() const
+{
+    return iFbo != NULL;
+}
+
+int
+BenchQuickHost::samples() const
+{
+    return iFbo ? iFbo->format().samples() : 0;
+}
+
+QQuickWindow*
+BenchQuickHost::window() const
+{
+    return iWindow;
+}
+
+QQuickItem*
+BenchQuickHost::contentItem() const
+{
+    return iWindow->contentItem();
+}
+
+void
+BenchQuickHost::frame(
+    qint64* aSyncNs,
+    qint64* aRenderNs)
+{
+    QElapsedTimer timer;
+    iRenderControl.polishItems();
+    timer.start();
+    iRenderControl.sync();
+    *aSyncNs = timer.nsecsElapsed();
+    timer.restart();
+    iRenderControl.render();
+    if (iResolveFbo) {
+        QOpenGLFramebufferObject::blitFramebuffer(iResolveFbo, iFbo);
+    }
+    iContext.functions()->glFinish();
+    *aRenderNs = timer.nsecsElapsed();
+}
+
+QImage
+BenchQuickHost::grab() const
+{
+    return iResolveFbo ? iResolveFbo->toImage() : iFbo ? iFbo->toImage() :
+        QImage();
+}
+
+void
+BenchQuickHost::countNodes(
+    QQuickItem* aItem,
+    int* aNodes,
+    int* aGeometryNodes,
+    int* aVertices)
+{
+    *aNodes = *aGeometryNodes = *aVertices = 0;
+    countNodes(QQuickItemPrivate::get(aItem)->itemNode(), aNodes,
+        aGeometryNodes, aVertices);
+}
+
+void
+BenchQuickHost::countNodes(
+    QSGNode* aNode,
+    int* aNodes,
+    int* aGeometryNodes,
+    int* aVertices)
+{
+    (*aNodes)++;
+    if (aNode->type() == QSGNode::GeometryNodeType) {
+        const QSGGeometry* g = static_cast<QSGGeometryNode*>(aNode)->geometry();
+        (*aGeometryNodes)++;
+        if (g) (*aVertices) += g->vertexCount();
+    }
+    for (QSGNode* n = aNode->firstChild(); n; n = n->nextSibling()) {
+        countNodes(n, aNodes, aGeometryNodes, aVertices);
+    }
+}
+
+// ==========================================================================
+// BenchClockHost
+// ==========================================================================
+
+BenchClockHost::BenchClockHost(
+    const QSize& aSize,
+    const QString& aStyle,
+    ClockSettings::RenderType aRenderType,
+    bool aInverted) :
+    BenchQuickHost(aSize),
+    iTimeSource(new BenchTimeSource),
+    iClock(NULL)
+{
+    if (BenchQuickHost::isValid()) {
+        // The clock picks up the shared instance when it's created
+        iTimeSource->setTime(BENCH_START_TIME);
+        ClockTimeSource::setSharedInstance(iTimeSource);
+        iClock = new QuickClock(contentItem());
+        iClock->setRenderType(aRenderType);
+        iClock->setStyle(aStyle);
+        iClock->setInvertColors(aInverted);
+        iClock->setSize(aSize);
+        QCoreApplication::processEvents();
+    }
+}
+
+BenchClockHost::~BenchClockHost()
+{
+    ClockTimeSource::setSharedInstance(QSharedPointer<ClockTimeSource>());
+}
+
+bool
+BenchClockHost::isValid() const
+{
+    return iClock != NULL;
+}
+
+QuickClock*
+BenchClockHost::clock() const
+{
+    return iClock;
+}
+
+QList<QuickClockLayer*>
+BenchClockHost::layers() const
+{
+    return iClock->findChildren<QuickClockLayer*>();
+}
+
+void
+BenchClockHost::setTime(
+    const QTime& aTime)
+{
+    iTimeSource->setTime(aTime);
+}
+
+// Normally the clock is updated by its timers or, while the hands are
+// moving, after every buffer swap. Here everything gets repainted,
+// whatever the timers would have done. Rebuild means initNode for every
+// layer.
+void
+BenchClockHost::invalidate(
+    bool aRebuild)
+{
+    const QList<QuickClockLayer*> list(layers());
+    iClock->update();
+    for (int i = 0; i < list.count(); i++) {
+        QuickClockLayer* layer = list.at(i);
+        if (aRebuild) {
+            QMetaObject::invokeMethod(layer, "onFullUpdateRequested");
+        } else {
+            layer->update();
+        }
+    }
+}
+
+// Renders a frame and returns its contents
+QImage
+BenchClockHost::render(
+    qint64* aFrameNs)
+{
+    qint64 syncNs, renderNs;
+    frame(&syncNs, &renderNs);
+    *aFrameNs = syncNs + renderNs;
+    return grab().convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BENCH_QUICK_HOST_H
+#define BENCH_QUICK_HOST_H
+
+#include "BenchCommon.h"
+#include "ClockSettings.h"
+
+#include <QImage>
+#include <QOpenGLContext>
+#include <QOffscreenSurface>
+#include <QQuickRenderControl>
+
+class QQuickItem;
+class QQuickWindow;
+class QOpenGLFramebufferObject;
+class QuickClock;
+class QuickClockLayer;
+
+// Offscreen window driven by QQuickRenderControl. Works with any GL
+// implementation, including Mesa llvmpipe. If the render target is
+// multisampled, each frame is resolved into a single sampled buffer,
+// the way it happens when the window is presented. The context format
+// (which is what ClockRenderer::featherWidth() looks at) is requested
+// separately.
+class BenchQuickHost {
+public:
+    BenchQuickHost(const QSize& aSize, int aSamples = 0,
+        int aContextSamples = 0);
+    virtual ~BenchQuickHost();
+
+    bool isValid() const;
+    int samples() const;
+    QQuickWindow* window() const;
+    QQuickItem* contentItem() const;
+    void frame(qint64* aSyncNs, qint64* aRenderNs);
+    QImage grab() const;
+
+    static void countNodes(QQuickItem* aItem, int* aNodes,
+        int* aGeometryNodes, int* aVertices);
+
+private:
+    static void countNodes(QSGNode* aNode, int* aNodes, int* aGeometryNodes,
+        int* aVertices);
+
+private:
+    QOpenGLContext iContext;
+    QOffscreenSurface iSurface;
+    QQuickRenderControl iRenderControl;
+    QQuickWindow* iWindow;
+    QOpenGLFramebufferObject* iFbo;
+    QOpenGLFramebufferObject* iResolveFbo;
+};
+
+// QuickClock in the offscreen window, driven by the virtual clock. The
+// time source is the shared instance for as long as the host exists.
+class BenchClockHost : public BenchQuickHost {
+public:
+    BenchClockHost(const QSize& aSize, const QString& aStyle,
+        ClockSettings::RenderType aRenderType, bool aInverted = false);
+    ~BenchClockHost();
+
+    bool isValid() const;
+    QuickClock* clock() const;
+    QList<QuickClockLayer*> layers() const;
+    void setTime(const QTime& aTime);
+    void invalidate(bool aRebuild);
+    QImage render(qint64* aFrameNs);
+
+private:
+    QSharedPointer<BenchTimeSource> iTimeSource;
+    QuickClock* iClock; // Deleted together with the window
+};
+
+#endif // BENCH_QUICK_HOST_H
@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BenchCommon.h"
+
+#include "ClockSecHandAtlas.h"
+
+#include <stdio.h>
+
+// Memory budget for the atlasSecHand case
+#define BENCH_ATLAS_BUDGET (16*1024*1024)
+
+enum RasterOp {
+    RasterDialPlate,
+    RasterHourMinHands,
+    RasterSecHand,
+    RasterAtlasSecHand,
+    RasterFullFrame,
+    RasterDirtyFrame,
+    RasterOpCount
+};
+
+static const char* const RASTER_OP_NAME[RasterOpCount] = {
+    "paintDialPlate",
+    "paintHourMinHands",
+    "paintSecHand",
+    "atlasSecHand",
+    "fullFrame",
+    "dirtyFrame"
+};
+
+// Paints one layer onto an offscreen image, the same way QuickClock does
+class RasterCase {
+public:
+    RasterCase(ClockRenderer* aRenderer, ClockTheme* aTheme,
+        const QSize& aSize, RasterOp aOp) :
+        iRenderer(aRenderer),
+        iTheme(aTheme),
+        iSize(aSize),
+        iOp(aOp),
+        iImage(aSize, QImage::Format_ARGB32_Premultiplied)
+        { iImage.fill(Qt::transparent); initLayer(); initAtlas(); }
+
+    void operator()(int aIteration);
+    const ClockSecHandAtlas& atlas() const { return iAtlas; }
+
+private:
+    void initLayer();
+    void initAtlas();
+    void paintFrame(QPainter* aPainter, const QTime& aTime);
+
+private:
+    ClockRenderer* iRenderer;
+    ClockTheme* iTheme;
+    QSize iSize;
+    RasterOp iOp;
+    QImage iImage;
+    QPixmap iLayer;
+    ClockSecHandAtlas iAtlas;
+};
+
+// The atlas is fully rendered upfront, to measure the steady state
+void
+RasterCase::initAtlas()
+{
+    if (iOp == RasterAtlasSecHand &&
+        iAtlas.setup(iRenderer, iTheme, iSize, BENCH_ATLAS_BUDGET)) {
+        QPainter painter(&iImage);
+        const int n = iAtlas.frameCount();
+        for (int i = 0; i < n; i++) {
+            iAtlas.paint(&painter, i*360.0/n);
+        }
+    }
+}
+
+// The full and dirty frame cases need the hour/minute layer
+void
+RasterCase::initLayer()
+{
+    if (iOp == RasterFullFrame || iOp == RasterDirtyFrame) {
+        iLayer = QPixmap(iSize);
+        iLayer.fill(Qt::transparent);
+        QPainter painter(&iLayer);
+        painter.setRenderHint(QPainter::Antialiasing);
+        iRenderer->paintDialPlate(&painter, iSize, iTheme, true);
+        iRenderer->paintHourMinHands(&painter, iSize, BENCH_START_TIME,
+            iTheme);
+    }
+}
+
+// What QuickClock::paint() does on every tick in non-optimized mode.
+// The dirty frame is clipped to the area swept by the second hand since
+// the previous tick, the same way QQuickPaintedItem does it.
+void
+RasterCase::paintFrame(
+    QPainter* aPainter,
+    const QTime& aTime)
+{
+    if (iOp == RasterDirtyFrame) {
+        const QTime prev(aTime.addMSecs(-BENCH_TIME_STEP_MS));
+        const QRect rect(iRenderer->secHandBounds(iSize, prev).
+            united(iRenderer->secHandBounds(iSize, aTime)));
+        aPainter->setClipRect(rect);
+        aPainter->setCompositionMode(QPainter::CompositionMode_Source);
+        aPainter->fillRect(rect, Qt::transparent);
+        aPainter->setCompositionMode(QPainter::CompositionMode_SourceOver);
+        aPainter->drawPixmap(rect.topLeft(), iLayer, rect);
+    } else {
+        aPainter->setCompositionMode(QPainter::CompositionMode_Source);
+        aPainter->fillRect(QRect(QPoint(0, 0), iSize), Qt::transparent);
+        aPainter->setCompositionMode(QPainter::CompositionMode_SourceOver);
+        aPainter->drawPixmap(0, 0, iLayer);
+    }
+    iRenderer->paintSecHand(aPainter, iSize, aTime, iTheme);
+}
+
+void
+RasterCase::operator()(
+    int aIteration)
+{
+    const QTime time(BENCH_START_TIME.addMSecs(aIteration*BENCH_TIME_STEP_MS));
+    QPainter painter(&iImage);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setRenderHint(QPainter::HighQualityAntialiasing);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    switch (iOp) {
+    case RasterDialPlate:
+        iRenderer->paintDialPlate(&painter, iSize, iTheme, true);
+        break;
+    case RasterHourMinHands:
+        iRenderer->paintHourMinHands(&painter, iSize, time, iTheme);
+        break;
+    case RasterSecHand:
+        iRenderer->paintSecHand(&painter, iSize, time, iTheme);
+        break;
+    case RasterAtlasSecHand:
+        // Falls back to painting the hand if the atlas doesn't fit
+        if (iAtlas.isValid()) {
+            iAtlas.paint(&painter, iRenderer->nodeAngle(ClockRenderer::NodeSec,
+                time));
+        } else {
+            iRenderer->paintSecHand(&painter, iSize, time, iTheme);
+        }
+        break;
+    case RasterFullFrame:
+    case RasterDirtyFrame:
+        paintFrame(&painter, time);
+        break;
+    case RasterOpCount:
+        break;
+    }
+}
+
+QJsonArray
+benchRaster(
+    const BenchOptions& aOptions)
+{
+    QJsonArray results;
+    ClockTheme* theme = ClockTheme::defaultTheme();
+    QList<ClockRenderer*> renderers = benchRenderers(aOptions);
+
+    printf("%-14s %5s %-18s %12s %12s %10s\n", "style", "size", "call",
+        "us/frame", "p95 us", "bytes/call");
+    for (int i = 0; i < renderers.count(); i++) {
+        ClockRenderer* renderer = renderers.at(i);
+        for (int j = 0; j < aOptions.iSizes.count(); j++) {
+            const int d = aOptions.iSizes.at(j);
+            const QSize size(d, d);
+            for (int op = 0; op < RasterOpCount; op++) {
+                RasterCase rasterCase(renderer, theme, size, (RasterOp)op);
+                BenchSamples samples(benchRun(aOptions, rasterCase));
+                QJsonObject result(samples.toJson());
+                result.insert("style", renderer->id());
+                result.insert("size", d);
+                result.insert("call", QString(RASTER_OP_NAME[op]));
+                if (op == RasterAtlasSecHand) {
+                    result.insert("atlas_frames", rasterCase.atlas().frameCount());
+                    result.insert("atlas_bytes", rasterCase.atlas().byteCount());
+                }
+                results.append(result);
+                printf("%-14s %5d %-18s %12.1f %12.1f %10.0f\n",
+                    qPrintable(renderer->id()), d, RASTER_OP_NAME[op],
+                    samples.mean()/1000.0, samples.percentile(95)/1000.0,
+                    result.value("bytes_per_call").toDouble());
+                fflush(stdout);
+            }
+        }
+    }
+    return results;
+}
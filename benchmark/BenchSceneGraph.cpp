@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BenchCommon.h"
+#include "BenchQuickHost.h"
+#include "QuickClock.h"
+#include "QuickClockLayer.h"
+
+#include <QSGGeometryNode>
+
+#include <private/qquickitem_p.h>
+
+#include <stdio.h>
+#include <string.h>
+
+enum SceneGraphFrame {
+    SceneGraphUpdate,
+    SceneGraphRebuild,
+    SceneGraphSplitMin,
+    SceneGraphFrameCount
+};
+
+static const char* const SCENE_GRAPH_FRAME_NAME[SceneGraphFrameCount] = {
+    "update",
+    "rebuild",
+    "3-node"
+};
+
+// Each iteration is a complete frame: updatePaintNode for all layers
+// (sync) followed by rendering and glFinish
+class SceneGraphCase {
+public:
+    SceneGraphCase(BenchClockHost* aHost, bool aRebuild) :
+        iHost(aHost), iRebuild(aRebuild), iFrames(0) {}
+
+    void operator()(int aIteration) {
+        qint64 syncNs, renderNs;
+        iHost->setTime(BENCH_START_TIME.addMSecs(aIteration *
+            BENCH_TIME_STEP_MS));
+        iHost->invalidate(iRebuild);
+        iHost->frame(&syncNs, &renderNs);
+        // The first (warm-up) frame is not counted
+        if (iFrames++) {
+            iSync.add(syncNs, 0, 0);
+            iRender.add(renderNs, 0, 0);
+        }
+    }
+
+    BenchClockHost* iHost;
+    bool iRebuild;
+    int iFrames;
+    BenchSamples iSync;
+    BenchSamples iRender;
+};
+
+// Batches and draw calls are counted from the debug output of the scene
+// graph renderer (QSG_RENDERER_DEBUG=render), which lists the batches
+// of every frame. A merged batch is drawn with a single call, an
+// unmerged one with a call per node.
+static QtMessageHandler sceneGraphPrevHandler = NULL;
+static int sceneGraphBatches = -1; // Negative if not counting
+static int sceneGraphDraws = 0;
+
+static void
+sceneGraphMessageHandler(
+    QtMsgType aType,
+    const QMessageLogContext& aContext,
+    const QString& aMessage)
+{
+    const bool batch = aMessage.contains("merged]");
+    if (aType == QtDebugMsg && (batch ||
+        aMessage.startsWith("Renderer::render()") ||
+        aMessage.startsWith("Rendering:"))) {
+        if (batch && sceneGraphBatches >= 0) {
+            const int pos = aMessage.indexOf("Nodes:");
+            sceneGraphBatches++;
+            if (aMessage.contains("[unmerged]") && pos >= 0) {
+                sceneGraphDraws += aMessage.mid(pos + 6).trimmed().
+                    section(' ', 0, 0).toInt();
+            } else {
+                sceneGraphDraws++;
+            }
+        }
+    } else if (sceneGraphPrevHandler) {
+        sceneGraphPrevHandler(aType, aContext, aMessage);
+    }
+}
+
+// Renders a frame and counts its batches and draw calls. Both are -1 if
+// the renderer didn't say anything (e.g. Qt was built without debug
+// output).
+static void
+sceneGraphCountDraws(
+    BenchClockHost* aHost,
+    bool aRebuild,
+    int* aBatches,
+    int* aDraws)
+{
+    qint64 syncNs, renderNs;
+    aHost->invalidate(aRebuild);
+    sceneGraphBatches = sceneGraphDraws = 0;
+    aHost->frame(&syncNs, &renderNs);
+    *aBatches = sceneGraphBatches ? sceneGraphBatches : -1;
+    *aDraws = sceneGraphBatches ? sceneGraphDraws : -1;
+    sceneGraphBatches = -1;
+}
+
+// Replaces the vertex colored minute hand node with a flat colored node
+// per shape (the hand and its two shadows), the way the minute hand used
+// to be built. Feathered edges (triangles fading out to transparent) are
+// dropped, the old nodes didn't have them.
+static bool
+sceneGraphSplitMinuteHand(
+    BenchClockHost* aHost)
+{
+    const QList<QuickClockLayer*> layers(aHost->layers());
+    for (int i = 0; i < layers.count(); i++) {
+        QuickClockLayer* layer = layers.at(i);
+        QSGNode* root = QQuickItemPrivate::get(layer)->paintNode;
+        if (layer->type() != ClockRenderer::NodeMin || !root) {
+            continue;
+        }
+        for (QSGNode* tx = root->firstChild(); tx; tx = tx->nextSibling()) {
+            for (QSGNode* n = tx->firstChild(); n; n = n->nextSibling()) {
+                const QSGGeometry* g = (n->type() ==
+                    QSGNode::GeometryNodeType) ?
+                    static_cast<QSGGeometryNode*>(n)->geometry() : NULL;
+                if (!g || g->drawingMode() != GL_TRIANGLES ||
+                    g->sizeOfVertex() != sizeof(QSGGeometry::ColoredPoint2D)) {
+                    continue;
+                }
+
+                const QSGGeometry::ColoredPoint2D* v =
+                    g->vertexDataAsColoredPoint2D();
+                const int count = g->vertexCount();
+                QVector<QSGGeometry::Point2D> points;
+                QRgb color = 0;
+                for (int k = 0; k <= count; k += 3) {
+                    const QSGGeometry::ColoredPoint2D* t = v + k;
+                    QRgb c = 0;
+                    if (k < count) {
+                        if (!t[0].a || !t[1].a || !t[2].a) {
+                            continue;
+                        }
+                        c = qRgba(t[0].r, t[0].g, t[0].b, t[0].a);
+                    }
+                    if (c != color && !points.isEmpty()) {
+                        QSGGeometry* shape = new QSGGeometry(
+                            QSGGeometry::defaultAttributes_Point2D(),
+                            points.count());
+                        shape->setDrawingMode(GL_TRIANGLES);
+                        memcpy(shape->vertexData(), points.constData(),
+                            points.count() * sizeof(points.at(0)));
+                        tx->insertChildNodeBefore(ClockRenderer::
+                            geometryNode(shape, QColor::fromRgba(
+                            qUnpremultiply(color))), n);
+                        points.resize(0);
+                    }
+                    color = c;
+                    for (int j = 0; j < 3 && k < count; j++) {
+                        QSGGeometry::Point2D p;
+                        p.set(t[j].x, t[j].y);
+                        points.append(p);
+                    }
+                }
+                tx->removeChildNode(n);
+                delete n;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+QJsonArray
+benchSceneGraph(
+    const BenchOptions& aOptions)
+{
+    QJsonArray results;
+
+    // The renderer reads this once, before the first frame
+    QByteArray debug(qgetenv("QSG_RENDERER_DEBUG"));
+    if (!debug.contains("render")) {
+        qputenv("QSG_RENDERER_DEBUG", debug.isEmpty() ? QByteArray("render") :
+            (debug + ",render"));
+    }
+    sceneGraphPrevHandler = qInstallMessageHandler(sceneGraphMessageHandler);
+
+    printf("%-14s %5s %-8s %12s %12s %12s %6s %6s %8s %7s %6s\n", "style",
+        "size", "frame", "sync us", "p95 us", "render us", "nodes", "geom",
+        "vertices", "batches", "draws");
+    for (int i = 0; i < aOptions.iStyles.count(); i++) {
+        const QString style(aOptions.iStyles.at(i));
+        for (int j = 0; j < aOptions.iSizes.count(); j++) {
+            const int d = aOptions.iSizes.at(j);
+            BenchClockHost host(QSize(d, d), style,
+                ClockSettings::RenderSpeed);
+            if (!host.isValid()) {
+                fprintf(stderr, "Failed to initialize OpenGL\n");
+                results.append(benchFailure("OpenGL"));
+                qInstallMessageHandler(sceneGraphPrevHandler);
+                return results;
+            }
+
+            // Steady state (only the transforms change), full rebuild
+            // (initNode for every layer) and steady state again with the
+            // minute hand split into three nodes, the way it used to be
+            for (int f = 0; f < SceneGraphFrameCount; f++) {
+                const bool rebuild = (f == SceneGraphRebuild);
+                if (f == SceneGraphSplitMin &&
+                    !sceneGraphSplitMinuteHand(&host)) {
+                    continue;
+                }
+
+                SceneGraphCase sgCase(&host, rebuild);
+                benchRun(aOptions, sgCase);
+
+                int nodes, geometryNodes, vertices, batches, draws;
+                BenchQuickHost::countNodes(host.clock(), &nodes,
+                    &geometryNodes, &vertices);
+                sceneGraphCountDraws(&host, rebuild, &batches, &draws);
+
+                const char* frame = SCENE_GRAPH_FRAME_NAME[f];
+                QJsonObject result;
+                result.insert("style", style);
+                result.insert("size", d);
+                result.insert("frame", QString(frame));
+                result.insert("sync", sgCase.iSync.toJson());
+                result.insert("render", sgCase.iRender.toJson());
+                result.insert("nodes", nodes);
+                result.insert("geometry_nodes", geometryNodes);
+                result.insert("vertices", vertices);
+                result.insert("batches", batches);
+                result.insert("draw_calls", draws);
+                results.append(result);
+                printf("%-14s %5d %-8s %12.1f %12.1f %12.1f %6d %6d %8d "
+                    "%7d %6d\n", qPrintable(style), d, frame,
+                    sgCase.iSync.mean()/1000.0,
+                    sgCase.iSync.percentile(95)/1000.0,
+                    sgCase.iRender.mean()/1000.0, nodes, geometryNodes,
+                    vertices, batches, draws);
+                fflush(stdout);
+            }
+        }
+    }
+    qInstallMessageHandler(sceneGraphPrevHandler);
+    return results;
+}
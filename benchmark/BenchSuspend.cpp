@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BenchCommon.h"
+#include "BenchQuickHost.h"
+#include "QuickClock.h"
+
+#include <QThread>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+
+#include <stdio.h>
+
+#define SUSPEND_SIZE (256)
+#define SUSPEND_ACTIVE_MS (1000)
+#define SUSPEND_OFF_MS (3000)
+
+static const char* const SUSPEND_RENDER_NAME[] = {
+    "raster",
+    "scenegraph"
+};
+
+static const ClockSettings::RenderType SUSPEND_RENDER_TYPE[] = {
+    ClockSettings::RenderQuality,
+    ClockSettings::RenderSpeed
+};
+
+// Runs the event loop for aMs, rendering whatever the clock asks for.
+// The virtual clock follows the real one.
+static void
+suspendRun(
+    BenchClockHost* aHost,
+    QElapsedTimer* aClock,
+    int aMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < aMs) {
+        qint64 syncNs, renderNs;
+        aHost->setTime(BENCH_START_TIME.addMSecs(aClock->elapsed()));
+        QCoreApplication::processEvents();
+        aHost->frame(&syncNs, &renderNs);
+        QThread::msleep(BENCH_TIME_STEP_MS);
+    }
+}
+
+// Runs each clock style for a while, then stops it (which is what happens
+// when the display goes off) and keeps running the event loop and the
+// renderer. Stopped clocks must neither wake up nor render anything,
+// and running ones must, otherwise the check proves nothing.
+QJsonArray
+benchSuspend(
+    const BenchOptions& aOptions)
+{
+    QJsonArray results;
+    const QSize size(SUSPEND_SIZE, SUSPEND_SIZE);
+
+    printf("%-14s %-10s %8s %8s %10s %10s %-6s\n", "style", "render",
+        "wakeups", "renders", "off wakeup", "off render", "status");
+    for (int i = 0; i < aOptions.iStyles.count(); i++) {
+        const QString style(aOptions.iStyles.at(i));
+        for (uint r = 0; r < sizeof(SUSPEND_RENDER_TYPE)/
+             sizeof(SUSPEND_RENDER_TYPE[0]); r++) {
+            BenchClockHost host(size, style, SUSPEND_RENDER_TYPE[r]);
+            if (!host.isValid()) {
+                fprintf(stderr, "Failed to initialize OpenGL\n");
+                results.append(benchFailure("OpenGL"));
+                return results;
+            }
+
+            QElapsedTimer clock;
+            QuickClock* quickClock = host.clock();
+            clock.start();
+            suspendRun(&host, &clock, SUSPEND_ACTIVE_MS);
+            const int wakeups = quickClock->wakeups();
+            const int renders = quickClock->renders();
+            quickClock->setRunning(false);
+
+            // Whatever had been requested before the clock was stopped
+            // may still get rendered, that's not counted
+            qint64 syncNs, renderNs;
+            host.frame(&syncNs, &renderNs);
+            const int wakeups0 = quickClock->suspendedWakeups();
+            const int renders0 = quickClock->suspendedRenders();
+            suspendRun(&host, &clock, SUSPEND_OFF_MS);
+
+            const int offWakeups = quickClock->suspendedWakeups() - wakeups0;
+            const int offRenders = quickClock->suspendedRenders() - renders0;
+            const bool ok = wakeups > 0 && renders > 0 && !offWakeups &&
+                !offRenders;
+            const QString status(ok ? "ok" : "FAIL");
+            QJsonObject result;
+            result.insert("style", style);
+            result.insert("render", QString(SUSPEND_RENDER_NAME[r]));
+            result.insert("wakeups", wakeups);
+            result.insert("renders", renders);
+            result.insert("suspended_wakeups", offWakeups);
+            result.insert("suspended_renders", offRenders);
+            result.insert("status", status);
+            results.append(result);
+            printf("%-14s %-10s %8d %8d %10d %10d %-6s\n", qPrintable(style),
+                SUSPEND_RENDER_NAME[r], wakeups, renders, offWakeups,
+                offRenders, qPrintable(status));
+            fflush(stdout);
+        }
+    }
+    return results;
+}
@@ -0,0 +1,493 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BenchCommon.h"
+#include "BenchQuickHost.h"
+#include "QuickClock.h"
+
+#include <QPainterPath>
+#include <QImage>
+#include <QSGGeometryNode>
+
+#include <private/qquickitem_p.h>
+
+#include <qmath.h>
+#include <stdio.h>
+
+// Mean distance between the legacy and the current outlines, in pixels
+#define TESSELLATION_MAX_ERROR (0.25)
+
+static const int TESSELLATION_RADII[] = {
+    2, 4, 8, 16, 32, 64, 128, 256, 512, 1024
+};
+#define TESSELLATION_RADII_COUNT \
+    (int)(sizeof(TESSELLATION_RADII)/sizeof(TESSELLATION_RADII[0]))
+
+#define TESSELLATION_DEFAULT_SIZES (QList<int>() << 128 << 400 << 1080)
+
+// The way ClockRenderer::circleGeometry used to do it, computing sin
+// and cos for each vertex. The number of segments used to be 8 per pixel
+// of radius.
+static QSGGeometry*
+legacyCircleGeometry(
+    const QPointF& aCenter,
+    qreal aRadius,
+    int n)
+{
+    const float x0 = aCenter.x();
+    const float y0 = aCenter.y();
+    QSGGeometry* g = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), n+2);
+    QSGGeometry::Point2D* v = g->vertexDataAsPoint2D();
+    g->setDrawingMode(GL_TRIANGLE_FAN);
+    v[0].x = x0;
+    v[0].y = y0;
+    for (int i=0; i<n; i++) {
+        const float theta = i*2*M_PI/n;
+        v[i+1].x = x0 + aRadius*cos(theta);
+        v[i+1].y = y0 + aRadius*sin(theta);
+    }
+    v[n+1] = v[1];
+    return g;
+}
+
+// The way ClockRenderer::ringGeometry used to do it
+static QSGGeometry*
+legacyRingGeometry(
+    const QPointF& aCenter,
+    qreal aRadius,
+    qreal aThickness,
+    int n)
+{
+    const float x0 = aCenter.x();
+    const float y0 = aCenter.y();
+    const float innerRadius = aRadius - qMin(aRadius, aThickness);
+    QSGGeometry* g = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 2*(n+1));
+    QSGGeometry::Point2D* v = g->vertexDataAsPoint2D();
+    g->setDrawingMode(GL_TRIANGLE_STRIP);
+    for (int i=0; i<n; i++) {
+        const float theta = i*2*M_PI/n;
+        v[2*i].x = x0 + innerRadius*cos(theta);
+        v[2*i].y = y0 + innerRadius*sin(theta);
+        v[2*i+1].x = x0 + aRadius*cos(theta);
+        v[2*i+1].y = y0 + aRadius*sin(theta);
+    }
+    v[2*n] = v[0];
+    v[2*n+1] = v[1];
+    return g;
+}
+
+// Outline of the triangle fan (the first vertex is the center)
+static QPainterPath
+circlePath(
+    const QSGGeometry* aGeometry)
+{
+    const QSGGeometry::Point2D* v = aGeometry->vertexDataAsPoint2D();
+    QPolygonF polygon;
+    for (int i = 1; i < aGeometry->vertexCount(); i++) {
+        polygon.append(QPointF(v[i].x, v[i].y));
+    }
+    QPainterPath path;
+    path.addPolygon(polygon);
+    return path;
+}
+
+// Outline of the triangle strip (inner and outer vertices alternate)
+static QPainterPath
+ringPath(
+    const QSGGeometry* aGeometry)
+{
+    const QSGGeometry::Point2D* v = aGeometry->vertexDataAsPoint2D();
+    QPolygonF inner, outer;
+    for (int i = 0; i + 1 < aGeometry->vertexCount(); i += 2) {
+        inner.append(QPointF(v[i].x, v[i].y));
+        outer.append(QPointF(v[i+1].x, v[i+1].y));
+    }
+    QPainterPath path;
+    path.setFillRule(Qt::OddEvenFill);
+    path.addPolygon(outer);
+    path.addPolygon(inner);
+    return path;
+}
+
+static QImage
+rasterize(
+    const QPainterPath& aPath,
+    int aSize)
+{
+    QImage image(aSize, aSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(Qt::black);
+    painter.drawPath(aPath);
+    return image;
+}
+
+// Returns the area (in pixels) covered by one image but not the other
+static qreal
+coverageDiff(
+    const QImage& aImage1,
+    const QImage& aImage2,
+    int* aMaxAlphaDiff)
+{
+    qint64 total = 0;
+    int maxDiff = 0;
+    for (int y = 0; y < aImage1.height(); y++) {
+        const QRgb* line1 = (const QRgb*)aImage1.constScanLine(y);
+        const QRgb* line2 = (const QRgb*)aImage2.constScanLine(y);
+        for (int x = 0; x < aImage1.width(); x++) {
+            const int diff = qAbs(qAlpha(line1[x]) - qAlpha(line2[x]));
+            total += diff;
+            maxDiff = qMax(maxDiff, diff);
+        }
+    }
+    *aMaxAlphaDiff = maxDiff;
+    return total / 255.0;
+}
+
+// Vertices of the scene graph clock, as built and as they would be with
+// the legacy tessellation of 8 segments per pixel of radius
+struct TessellationCount {
+    int iCircular;
+    int iVertices;
+    int iLegacyVertices;
+};
+
+static inline bool
+samePoint(
+    const QSGGeometry::ColoredPoint2D& aPoint1,
+    const QSGGeometry::ColoredPoint2D& aPoint2)
+{
+    return aPoint1.x == aPoint2.x && aPoint1.y == aPoint2.y;
+}
+
+// Checks whether the points are on a circle and returns its radius
+static bool
+circleRadius(
+    const QPolygonF& aPoints,
+    qreal* aRadius)
+{
+    QPointF center(0, 0);
+    for (int i = 0; i < aPoints.count(); i++) {
+        center += aPoints.at(i);
+    }
+    center /= aPoints.count();
+    qreal minR = -1, maxR = 0;
+    for (int i = 0; i < aPoints.count(); i++) {
+        const QPointF d(aPoints.at(i) - center);
+        const qreal r = sqrt(QPointF::dotProduct(d, d));
+        maxR = qMax(maxR, r);
+        minR = (minR < 0) ? r : qMin(minR, r);
+    }
+    *aRadius = maxR;
+    return maxR > 0 && (maxR - minR) < qMax(maxR / 100, qreal(0.01));
+}
+
+static inline int
+legacySegments(
+    qreal aRadius)
+{
+    return qMax(qRound(8 * aRadius), 4);
+}
+
+// ClockGeometryBuilder turns a circle into a fan of n-2 triangles and
+// each band of a ring (and the feathered edge of any shape) into a
+// closed strip of 2n triangles. Those runs which have at least 8
+// segments and lie on a circle are counted again with the legacy number
+// of segments. Everything else is the same before and after.
+static void
+tessellationGeometry(
+    const QSGGeometry* aGeometry,
+    TessellationCount* aCount)
+{
+    const int count = aGeometry->vertexCount();
+    aCount->iVertices += count;
+    if (aGeometry->drawingMode() != GL_TRIANGLES ||
+        aGeometry->sizeOfVertex() != sizeof(QSGGeometry::ColoredPoint2D)) {
+        aCount->iLegacyVertices += count;
+        return;
+    }
+
+    const QSGGeometry::ColoredPoint2D* v =
+        aGeometry->vertexDataAsColoredPoint2D();
+    const int triangles = count / 3;
+    int legacy = count;
+    int i = 0;
+    while (i < triangles) {
+        // Fan: (p0, p1, p2), (p0, p2, p3) ...
+        int j = i + 1;
+        while (j < triangles && samePoint(v[3*j], v[3*i]) &&
+            samePoint(v[3*j+1], v[3*(j-1)+2])) {
+            j++;
+        }
+        if (j - i >= 6) {
+            QPolygonF points;
+            points.append(QPointF(v[3*i].x, v[3*i].y));
+            points.append(QPointF(v[3*i+1].x, v[3*i+1].y));
+            for (int k = i; k < j; k++) {
+                points.append(QPointF(v[3*k+2].x, v[3*k+2].y));
+            }
+            qreal r;
+            if (circleRadius(points, &r)) {
+                legacy += 3 * (legacySegments(r) - 2 - (j - i));
+                aCount->iCircular++;
+                i = j;
+                continue;
+            }
+        }
+
+        // Band: (a1, a2, b2), (a1, b2, b1), (a2, a3, b3), (a2, b3, b2) ...
+        int n = 0;
+        while (i + 2*n + 1 < triangles) {
+            const QSGGeometry::ColoredPoint2D* t1 = v + 3*(i + 2*n);
+            const QSGGeometry::ColoredPoint2D* t2 = t1 + 3;
+            if (!samePoint(t2[0], t1[0]) || !samePoint(t2[1], t1[2]) ||
+                (n && (!samePoint(t1[0], t1[-5]) ||
+                !samePoint(t2[2], t1[-4])))) {
+                break;
+            }
+            n++;
+        }
+        if (n >= 8 && samePoint(v[3*(i + 2*n - 2) + 1], v[3*i])) {
+            QPolygonF points;
+            for (int k = 0; k < n; k++) {
+                const QSGGeometry::ColoredPoint2D& p = v[3*(i + 2*k) + 2];
+                points.append(QPointF(p.x, p.y));
+            }
+            qreal r;
+            if (circleRadius(points, &r)) {
+                legacy += 6 * (legacySegments(r) - n);
+                aCount->iCircular++;
+                i += 2*n;
+                continue;
+            }
+        }
+        i++;
+    }
+    aCount->iLegacyVertices += legacy;
+}
+
+static void
+tessellationNode(
+    QSGNode* aNode,
+    TessellationCount* aCount)
+{
+    if (aNode->type() == QSGNode::GeometryNodeType) {
+        const QSGGeometry* g = static_cast<QSGGeometryNode*>(aNode)->geometry();
+        if (g) tessellationGeometry(g, aCount);
+    }
+    for (QSGNode* n = aNode->firstChild(); n; n = n->nextSibling()) {
+        tessellationNode(n, aCount);
+    }
+}
+
+// Walks the nodes (hands, center disks, rings and the dial plate) of the
+// scene graph clock of the given style after the first frame
+static bool
+tessellationStyle(
+    const QString& aStyle,
+    int aSize,
+    TessellationCount* aCount)
+{
+    BenchClockHost host(QSize(aSize, aSize), aStyle,
+        ClockSettings::RenderSpeed);
+    aCount->iCircular = aCount->iVertices = aCount->iLegacyVertices = 0;
+    if (host.isValid()) {
+        qint64 ns;
+        host.render(&ns);
+        tessellationNode(QQuickItemPrivate::get(host.clock())->itemNode(),
+            aCount);
+        return true;
+    }
+    return false;
+}
+
+// Rasterizes circles and rings tessellated the old way and the current
+// way and compares the coverage. The difference in area divided by the
+// length of the outline(s) gives the mean deviation of the outline.
+// Then adds up the circle and ring vertices of each style, before and
+// after.
+QJsonArray
+benchTessellation(
+    const BenchOptions& aOptions)
+{
+    QJsonArray results;
+    const QList<int> sizes(aOptions.iSizesSet ? aOptions.iSizes :
+        TESSELLATION_DEFAULT_SIZES);
+
+    printf("%-6s %6s %10s %10s %10s %8s\n", "shape", "radius", "legacy",
+        "vertices", "error px", "max diff");
+    for (int i = 0; i < TESSELLATION_RADII_COUNT; i++) {
+        const int r = TESSELLATION_RADII[i];
+        const int size = 2*r + 4;
+        const QPointF center(size/2.0, size/2.0);
+        const qreal thickness = qMax(r/4.0, 1.0);
+
+        for (int ring = 0; ring < 2; ring++) {
+            QSGGeometry* legacy = ring ?
+                legacyRingGeometry(center, r, thickness, 8*r) :
+                legacyCircleGeometry(center, r, 8*r);
+            QSGGeometry* current = ring ?
+                ClockRenderer::ringGeometry(center, r, thickness) :
+                ClockRenderer::circleGeometry(center, r);
+            const QImage image1(rasterize(ring ? ringPath(legacy) :
+                circlePath(legacy), size));
+            const QImage image2(rasterize(ring ? ringPath(current) :
+                circlePath(current), size));
+            const qreal outline = 2 * M_PI * (ring ? (2*r - thickness) : r);
+            int maxDiff;
+            const qreal error = coverageDiff(image1, image2, &maxDiff) /
+                outline;
+            const char* shape = ring ? "ring" : "circle";
+
+            QJsonObject result;
+            result.insert("shape", QString(shape));
+            result.insert("radius", r);
+            result.insert("legacy_vertices", legacy->vertexCount());
+            result.insert("vertices", current->vertexCount());
+            result.insert("error_px", error);
+            result.insert("max_alpha_diff", maxDiff);
+            if (error > TESSELLATION_MAX_ERROR) {
+                result.insert("status", QString("FAIL"));
+            }
+            results.append(result);
+            printf("%-6s %6d %10d %10d %10.3f %8d%s\n", shape, r,
+                legacy->vertexCount(), current->vertexCount(), error,
+                maxDiff, (error > TESSELLATION_MAX_ERROR) ?
+                "  TOO INACCURATE" : "");
+            delete legacy;
+            delete current;
+        }
+    }
+
+    printf("\n%-14s %5s %8s %10s %10s %8s\n", "style", "size", "circular",
+        "legacy", "vertices", "saved");
+    for (int i = 0; i < aOptions.iStyles.count(); i++) {
+        const QString style(aOptions.iStyles.at(i));
+        for (int j = 0; j < sizes.count(); j++) {
+            const int d = sizes.at(j);
+            TessellationCount stats;
+            if (!tessellationStyle(style, d, &stats)) {
+                fprintf(stderr, "Failed to initialize OpenGL\n");
+                results.append(benchFailure("OpenGL"));
+                return results;
+            }
+
+            const qreal saved = stats.iLegacyVertices ? (100.0 *
+                (stats.iLegacyVertices - stats.iVertices) /
+                stats.iLegacyVertices) : 0;
+            QJsonObject result;
+            result.insert("style", style);
+            result.insert("size", d);
+            result.insert("circular", stats.iCircular);
+            result.insert("legacy_vertices", stats.iLegacyVertices);
+            result.insert("vertices", stats.iVertices);
+            results.append(result);
+            printf("%-14s %5d %8d %10d %10d %7.1f%%\n", qPrintable(style),
+                d, stats.iCircular, stats.iLegacyVertices, stats.iVertices,
+                saved);
+            fflush(stdout);
+        }
+    }
+    return results;
+}
+
+// Generates a circle or a ring geometry the old or the new way
+class GeometryCase {
+public:
+    GeometryCase(bool aRing, bool aLegacy, int aRadius) :
+        iRing(aRing), iLegacy(aLegacy), iRadius(aRadius),
+        iThickness(qMax(aRadius/4.0, 1.0)),
+        iSegments(ClockRenderer::circleSegments(aRadius)) {}
+
+    void operator()(int aIteration);
+
+private:
+    const bool iRing;
+    const bool iLegacy;
+    const int iRadius;
+    const qreal iThickness;
+    const int iSegments;
+};
+
+void
+GeometryCase::operator()(
+    int aIteration)
+{
+    const QPointF center(iRadius + aIteration % 2, iRadius);
+    QSGGeometry* g = iRing ? (iLegacy ?
+        legacyRingGeometry(center, iRadius, iThickness, iSegments) :
+        ClockRenderer::ringGeometry(center, iRadius, iThickness)) :
+        (iLegacy ? legacyCircleGeometry(center, iRadius, iSegments) :
+        ClockRenderer::circleGeometry(center, iRadius));
+    delete g;
+}
+
+// Compares sin/cos per vertex against the shared unit circle tables,
+// with the same number of segments
+QJsonArray
+benchGeometry(
+    const BenchOptions& aOptions)
+{
+    QJsonArray results;
+
+    printf("%-6s %6s %8s %-10s %12s %12s\n", "shape", "radius", "segments",
+        "generator", "ns/call", "p95 ns");
+    for (int i = 0; i < TESSELLATION_RADII_COUNT; i++) {
+        const int r = TESSELLATION_RADII[i];
+        for (int ring = 0; ring < 2; ring++) {
+            for (int legacy = 1; legacy >= 0; legacy--) {
+                GeometryCase geometryCase(ring, legacy, r);
+                BenchSamples samples(benchRun(aOptions, geometryCase));
+                QJsonObject result(samples.toJson());
+                const char* shape = ring ? "ring" : "circle";
+                const char* generator = legacy ? "trig" : "table";
+                result.insert("shape", QString(shape));
+                result.insert("radius", r);
+                result.insert("segments", ClockRenderer::circleSegments(r));
+                result.insert("generator", QString(generator));
+                results.append(result);
+                printf("%-6s %6d %8d %-10s %12lld %12lld\n", shape, r,
+                    ClockRenderer::circleSegments(r), generator,
+                    samples.mean(), samples.percentile(95));
+            }
+        }
+    }
+    return results;
+}
@@ -0,0 +1,88 @@
+TEMPLATE = app
+TARGET = clockbench
+CONFIG += console c++11
+CONFIG -= app_bundle
+QT += gui quick quick-private dbus
+QMAKE_CXXFLAGS += -Wno-unused-parameter -Wno-psabi
+
+CONFIG(debug, debug|release) {
+  QMAKE_CXXFLAGS += -g -O0
+  DEFINES += HARBOUR_DEBUG
+}
+
+# Let the compiler vectorize vertex generation loops
+CONFIG(release, debug|release) {
+  QMAKE_CXXFLAGS += -ftree-vectorize
+}
+
+CLOCK_SRC = $${_PRO_FILE_PWD_}/../src
+HARBOUR_LIB = $${_PRO_FILE_PWD_}/../harbour-lib
+HARBOUR_SRC = $${HARBOUR_LIB}/src
+HARBOUR_INCLUDE = $${HARBOUR_LIB}/include
+INCLUDEPATH += $${CLOCK_SRC} $${HARBOUR_INCLUDE}
+
+SOURCES += \
+    main.cpp \
+    BenchAccuracy.cpp \
+    BenchAntialias.cpp \
+    BenchCommon.cpp \
+    BenchDial.cpp \
+    BenchGolden.cpp \
+    BenchLayers.cpp \
+    BenchMotion.cpp \
+    BenchParity.cpp \
+    BenchQuickHost.cpp \
+    BenchRaster.cpp \
+    BenchSceneGraph.cpp \
+    BenchSuspend.cpp \
+    BenchTessellation.cpp
+
+HEADERS += \
+    BenchCommon.h \
+    BenchQuickHost.h
+
+SOURCES += \
+    $${CLOCK_SRC}/ClockDialCache.cpp \
+    $${CLOCK_SRC}/ClockDialTicks.cpp \
+    $${CLOCK_SRC}/ClockFrameDriver.cpp \
+    $${CLOCK_SRC}/ClockFrameStats.cpp \
+    $${CLOCK_SRC}/ClockGeometryBuilder.cpp \
+    $${CLOCK_SRC}/ClockHourMinLayer.cpp \
+    $${CLOCK_SRC}/ClockMotionProfile.cpp \
+    $${CLOCK_SRC}/ClockRenderer.cpp \
+    $${CLOCK_SRC}/ClockRendererDeutscheBahn.cpp \
+    $${CLOCK_SRC}/ClockRendererHelsinkiMetro.cpp \
+    $${CLOCK_SRC}/ClockRendererSwissRailroad.cpp \
+    $${CLOCK_SRC}/ClockScheduler.cpp \
+    $${CLOCK_SRC}/ClockSecHandAtlas.cpp \
+    $${CLOCK_SRC}/ClockTheme.cpp \
+    $${CLOCK_SRC}/ClockTimeSource.cpp \
+    $${CLOCK_SRC}/QuickClock.cpp \
+    $${CLOCK_SRC}/QuickClockLayer.cpp
+
+# ClockSettings.h is included but not built, to avoid pulling in mlite
+HEADERS += \
+    $${CLOCK_SRC}/ClockDebug.h \
+    $${CLOCK_SRC}/ClockDialCache.h \
+    $${CLOCK_SRC}/ClockDialTicks.h \
+    $${CLOCK_SRC}/ClockFrameDriver.h \
+    $${CLOCK_SRC}/ClockFrameStats.h \
+    $${CLOCK_SRC}/ClockGeometryBuilder.h \
+    $${CLOCK_SRC}/ClockGeometryCache.h \
+    $${CLOCK_SRC}/ClockHourMinLayer.h \
+    $${CLOCK_SRC}/ClockMotionProfile.h \
+    $${CLOCK_SRC}/ClockRenderer.h \
+    $${CLOCK_SRC}/ClockScheduler.h \
+    $${CLOCK_SRC}/ClockSecHandAtlas.h \
+    $${CLOCK_SRC}/ClockTheme.h \
+    $${CLOCK_SRC}/ClockTimeSource.h \
+    $${CLOCK_SRC}/QuickClock.h \
+    $${CLOCK_SRC}/QuickClockLayer.h
+
+SOURCES += \
+    $${HARBOUR_SRC}/HarbourMce.cpp \
+    $${HARBOUR_SRC}/HarbourSystemState.cpp
+
+HEADERS += \
+    $${HARBOUR_INCLUDE}/HarbourSystemState.h \
+    $${HARBOUR_SRC}/HarbourMce.h
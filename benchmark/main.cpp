@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BenchCommon.h"
+#include "ClockDebug.h"
+
+#include <QFile>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QGuiApplication>
+#include <QCommandLineParser>
+
+#include <stdio.h>
+
+#define MODE_ACCURACY "accuracy"
+#define MODE_ANTIALIAS "antialias"
+#define MODE_DIAL "dial"
+#define MODE_GEOMETRY "geometry"
+#define MODE_GOLDEN "golden"
+#define MODE_LAYERS "layers"
+#define MODE_MOTION "motion"
+#define MODE_PARITY "parity"
+#define MODE_RASTER "raster"
+#define MODE_SCENEGRAPH "scenegraph"
+#define MODE_SUSPEND "suspend"
+#define MODE_TESSELLATION "tessellation"
+
+static QList<int>
+parseSizes(
+    const QString& aValue)
+{
+    QList<int> sizes;
+    const QStringList list(aValue.split(',', QString::SkipEmptyParts));
+    for (int i = 0; i < list.count(); i++) {
+        bool ok = false;
+        const int size = list.at(i).trimmed().toInt(&ok);
+        if (ok && size > 0) {
+            sizes.append(size);
+        } else {
+            HWARN("Invalid size" << list.at(i));
+        }
+    }
+    return sizes;
+}
+
+int main(int argc, char *argv[])
+{
+    // The benchmark doesn't need a display
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QGuiApplication app(argc, argv);
+    QCommandLineParser parser;
+    BenchOptions options;
+
+    parser.setApplicationDescription("Swiss clock renderer benchmark");
+    parser.addHelpOption();
+    parser.addPositionalArgument("mode", "Benchmark to run: "
+        MODE_RASTER " (default), " MODE_SCENEGRAPH ", " MODE_LAYERS ", "
+        MODE_TESSELLATION ", " MODE_GEOMETRY ", " MODE_ANTIALIAS ", "
+        MODE_DIAL ", " MODE_ACCURACY ", " MODE_GOLDEN ", " MODE_PARITY ", "
+        MODE_MOTION " or " MODE_SUSPEND,
+        "[" MODE_RASTER "|" MODE_SCENEGRAPH "|" MODE_LAYERS "|"
+        MODE_TESSELLATION "|" MODE_GEOMETRY "|" MODE_ANTIALIAS "|"
+        MODE_DIAL "|" MODE_ACCURACY "|" MODE_GOLDEN "|" MODE_PARITY "|"
+        MODE_MOTION "|" MODE_SUSPEND "]");
+    QCommandLineOption outputOption(QStringList() << "o" << "output",
+        "Write JSON results to <file>.", "file");
+    QCommandLineOption sizesOption(QStringList() << "s" << "sizes",
+        "Comma-separated list of clock sizes.", "sizes");
+    QCommandLineOption stylesOption(QStringList() << "S" << "styles",
+        "Comma-separated list of clock styles.", "styles");
+    QCommandLineOption iterationsOption(QStringList() << "n" << "iterations",
+        "Maximum number of iterations per case.", "count");
+    QCommandLineOption budgetOption(QStringList() << "t" << "time",
+        "Time budget per case, in milliseconds.", "ms");
+    QCommandLineOption goldenOption(QStringList() << "g" << "golden",
+        "Directory with the golden images.", "dir");
+    QCommandLineOption updateOption(QStringList() << "u" << "update",
+        "Write the golden images instead of comparing.");
+    QCommandLineOption renderOption(QStringList() << "r" << "render",
+        "Comma-separated list of render paths (raster, scenegraph).",
+        "paths");
+    parser.addOption(outputOption);
+    parser.addOption(sizesOption);
+    parser.addOption(stylesOption);
+    parser.addOption(iterationsOption);
+    parser.addOption(budgetOption);
+    parser.addOption(goldenOption);
+    parser.addOption(updateOption);
+    parser.addOption(renderOption);
+    parser.process(app);
+
+    if (parser.isSet(sizesOption)) {
+        options.iSizes = parseSizes(parser.value(sizesOption));
+        options.iSizesSet = true;
+    }
+    if (parser.isSet(stylesOption)) {
+        options.iStyles = parser.value(stylesOption).split(',',
+            QString::SkipEmptyParts);
+    }
+    if (parser.isSet(iterationsOption)) {
+        options.iMaxIterations = qMax(parser.value(iterationsOption).toInt(),
+            options.iMinIterations);
+    }
+    if (parser.isSet(budgetOption)) {
+        options.iTimeBudgetMs = qMax(parser.value(budgetOption).toInt(), 0);
+    }
+    if (parser.isSet(goldenOption)) {
+        options.iGoldenDir = parser.value(goldenOption);
+    }
+    options.iUpdateGolden = parser.isSet(updateOption);
+    if (parser.isSet(renderOption)) {
+        options.iRenderPaths = parser.value(renderOption).split(',',
+            QString::SkipEmptyParts);
+    }
+
+    const QStringList args(parser.positionalArguments());
+    const QString mode(args.isEmpty() ? QString(MODE_RASTER) : args.at(0));
+    QJsonArray results;
+    if (mode == MODE_RASTER) {
+        results = benchRaster(options);
+    } else if (mode == MODE_LAYERS) {
+        results = benchLayers(options);
+    } else if (mode == MODE_SCENEGRAPH) {
+        results = benchSceneGraph(options);
+    } else if (mode == MODE_TESSELLATION) {
+        results = benchTessellation(options);
+    } else if (mode == MODE_GEOMETRY) {
+        results = benchGeometry(options);
+    } else if (mode == MODE_ANTIALIAS) {
+        results = benchAntialias(options);
+    } else if (mode == MODE_DIAL) {
+        results = benchDial(options);
+    } else if (mode == MODE_ACCURACY) {
+        results = benchAccuracy(options);
+    } else if (mode == MODE_GOLDEN) {
+        results = benchGolden(options);
+    } else if (mode == MODE_PARITY) {
+        results = benchParity(options);
+    } else if (mode == MODE_MOTION) {
+        results = benchMotion(options);
+    } else if (mode == MODE_SUSPEND) {
+        results = benchSuspend(options);
+    } else {
+        fprintf(stderr, "Unknown benchmark '%s'\n", qPrintable(mode));
+        return 1;
+    }
+
+    if (parser.isSet(outputOption)) {
+        QJsonObject root;
+        root.insert("benchmark", mode);
+        root.insert("qt", QString(qVersion()));
+        root.insert("timestamp",
+            QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+        root.insert("results", results);
+
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+            file.write(QJsonDocument(root).toJson()) < 0) {
+            fprintf(stderr, "Failed to write %s\n", qPrintable(file.fileName()));
+            return 1;
+        }
+    }
+
+    // Failed checks (e.g. frames which don't match the golden images)
+    // fail the run
+    for (int i = 0; i < results.count(); i++) {
+        if (results.at(i).toObject().value("status").toString() == "FAIL") {
+            return 2;
+        }
+    }
+    return 0;
+}
@@ -25,22 +25,48 @@ CONFIG(debug, debug|release) {
   DEFINES += HARBOUR_DEBUG
 }
 
+# Let the compiler vectorize vertex generation loops
+CONFIG(release, debug|release) {
+  QMAKE_CXXFLAGS += -ftree-vectorize
+}
+
 SOURCES += \
     src/main.cpp \
+    src/ClockDialCache.cpp \
+    src/ClockDialTicks.cpp \
+    src/ClockFrameDriver.cpp \
+    src/ClockFrameStats.cpp \
+    src/ClockGeometryBuilder.cpp \
+    src/ClockHourMinLayer.cpp \
+    src/ClockMotionProfile.cpp \
     src/ClockRenderer.cpp \
     src/ClockRendererDeutscheBahn.cpp \
     src/ClockRendererHelsinkiMetro.cpp \
     src/ClockRendererSwissRailroad.cpp \
+    src/ClockScheduler.cpp \
+    src/ClockSecHandAtlas.cpp \
     src/ClockSettings.cpp \
     src/ClockTheme.cpp \
+    src/ClockTimeSource.cpp \
     src/QuickClock.cpp \
     src/QuickClockLayer.cpp
 
 HEADERS += \
     src/ClockDebug.h \
+    src/ClockDialCache.h \
+    src/ClockDialTicks.h \
+    src/ClockFrameDriver.h \
+    src/ClockFrameStats.h \
+    src/ClockGeometryBuilder.h \
+    src/ClockGeometryCache.h \
+    src/ClockHourMinLayer.h \
+    src/ClockMotionProfile.h \
     src/ClockRenderer.h \
+    src/ClockScheduler.h \
+    src/ClockSecHandAtlas.h \
     src/ClockSettings.h \
     src/ClockTheme.h \
+    src/ClockTimeSource.h \
     src/QuickClock.h \
     src/QuickClockLayer.h
 
@@ -43,6 +43,8 @@ CoverBackground {
         invertColors: true
         style: ClockSettings.clockStyle
         renderType: ClockSettings.renderType
+        secHandAtlasBudget: ClockSettings.secHandAtlasBudget
+        ambientMode: ClockSettings.ambientMode
         anchors.centerIn: parent
         width: Math.floor(Math.ceil(parent.width - 2*Theme.paddingMedium*parent.width/Theme.coverSizeLarge.width)/2)*2
         height: width
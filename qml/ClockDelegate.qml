@@ -49,6 +49,8 @@ Item {
     property var settings: ClockSettings
     readonly property bool showNumbers: settings && settings.showNumbers
     readonly property int renderType: settings ? settings.renderType : 0
+    readonly property int secHandAtlasBudget: settings ? settings.secHandAtlasBudget : 0
+    readonly property int ambientMode: settings ? settings.ambientMode : 0
     readonly property bool invertColors: settings && settings.invertColors
     readonly property bool hidingNumbersWhenFlicking: flicking && !landscape
 
@@ -101,6 +103,8 @@ Item {
                     drawBackground: true
                     invertColors: delegate.invertColors
                     renderType: delegate.renderType
+                    secHandAtlasBudget: delegate.secHandAtlasBudget
+                    ambientMode: delegate.ambientMode
                     running: selected || flicking
                     MouseArea {
                         anchors.fill: parent
@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "ClockDialCache.h"
+#include "ClockDebug.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+
+// Number of dials not used by anyone that are kept in the cache
+#define MAX_UNUSED_DIALS (3)
+
+// ==========================================================================
+// ClockDialCache::Private
+// ==========================================================================
+
+class ClockDialCache::Private
+{
+public:
+    class Entry {
+    public:
+        Entry(ClockRenderer* aRenderer, const QSize& aSize,
+            ClockTheme* aTheme, bool aDrawBackground);
+
+        bool matches(ClockRenderer* aRenderer, const QSize& aSize,
+            ClockTheme* aTheme, bool aDrawBackground) const;
+
+        ClockRenderer* const iRenderer;
+        const QSize iSize;
+        ClockTheme* const iTheme;
+        const bool iDrawBackground;
+        QPixmap iPixmap;
+        int iRefCount;
+    };
+
+    Private();
+    ~Private();
+
+    void trim();
+
+public:
+    QMutex iMutex;
+    QList<Entry*> iEntries; // Most recently used first
+    int iHits;
+    int iMisses;
+};
+
+ClockDialCache::Private::Entry::Entry(
+    ClockRenderer* aRenderer,
+    const QSize& aSize,
+    ClockTheme* aTheme,
+    bool aDrawBackground) :
+    iRenderer(aRenderer),
+    iSize(aSize),
+    iTheme(aTheme),
+    iDrawBackground(aDrawBackground),
+    iPixmap(aSize),
+    iRefCount(1)
+{
+}
+
+inline bool
+ClockDialCache::Private::Entry::matches(
+    ClockRenderer* aRenderer,
+    const QSize& aSize,
+    ClockTheme* aTheme,
+    bool aDrawBackground) const
+{
+    // Renderers and themes are singletons
+    return iRenderer == aRenderer && iSize == aSize && iTheme == aTheme &&
+        iDrawBackground == aDrawBackground;
+}
+
+ClockDialCache::Private::Private() :
+    iHits(0),
+    iMisses(0)
+{
+}
+
+ClockDialCache::Private::~Private()
+{
+    qDeleteAll(iEntries);
+}
+
+void
+ClockDialCache::Private::trim()
+{
+    // Drop the least recently used dials nobody is using
+    int unused = 0;
+    for (int i = 0; i < iEntries.count(); i++) {
+        Entry* entry = iEntries.at(i);
+        if (!entry->iRefCount && ++unused > MAX_UNUSED_DIALS) {
+            HDEBUG("dropping" << qPrintable(entry->iRenderer->id()) <<
+                "dial" << entry->iSize.width() << "x" <<
+                entry->iSize.height());
+            iEntries.removeAt(i--);
+            delete entry;
+        }
+    }
+}
+
+// ==========================================================================
+// ClockDialCache
+// ==========================================================================
+
+ClockDialCache::ClockDialCache() :
+    iPrivate(new Private)
+{
+}
+
+ClockDialCache::~ClockDialCache()
+{
+    HDEBUG(iPrivate->iHits << "hits," << iPrivate->iMisses << "misses");
+    delete iPrivate;
+}
+
+QSharedPointer<ClockDialCache>
+ClockDialCache::sharedInstance()
+{
+    static QWeakPointer<ClockDialCache> sharedInstance;
+    QSharedPointer<ClockDialCache> instance = sharedInstance;
+    if (instance.isNull()) {
+        // QSharedPointer::create() can't access the private constructor
+        instance = QSharedPointer<ClockDialCache>(new ClockDialCache);
+        sharedInstance = instance;
+    }
+    return instance;
+}
+
+const QPixmap*
+ClockDialCache::acquire(
+    ClockRenderer* aRenderer,
+    const QSize& aSize,
+    ClockTheme* aTheme,
+    bool aDrawBackground)
+{
+    const QString style(aRenderer->id());
+    QMutexLocker lock(&iPrivate->iMutex);
+    QList<Private::Entry*>& entries = iPrivate->iEntries;
+    for (int i = 0; i < entries.count(); i++) {
+        Private::Entry* entry = entries.at(i);
+        if (entry->matches(aRenderer, aSize, aTheme, aDrawBackground)) {
+            iPrivate->iHits++;
+            entry->iRefCount++;
+            entries.move(i, 0);
+            HDEBUG(qPrintable(style) << aSize.width() << "x" <<
+                aSize.height() << "hit" << iPrivate->iHits << "/" <<
+                iPrivate->iMisses);
+            return &entry->iPixmap;
+        }
+    }
+
+    iPrivate->iMisses++;
+    HDEBUG("drawing" << qPrintable(style) << "dial plate" << aSize.width() <<
+        "x" << aSize.height() << "miss" << iPrivate->iMisses << "/" <<
+        iPrivate->iHits);
+    Private::Entry* entry = new Private::Entry(aRenderer, aSize, aTheme,
+        aDrawBackground);
+    entry->iPixmap.fill(Qt::transparent);
+    QPainter painter(&entry->iPixmap);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setRenderHint(QPainter::HighQualityAntialiasing);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    aRenderer->paintDialPlate(&painter, aSize, aTheme, aDrawBackground);
+    entries.insert(0, entry);
+    iPrivate->trim();
+    return &entry->iPixmap;
+}
+
+void
+ClockDialCache::release(
+    const QPixmap* aPixmap)
+{
+    if (aPixmap) {
+        QMutexLocker lock(&iPrivate->iMutex);
+        QList<Private::Entry*>& entries = iPrivate->iEntries;
+        for (int i = 0; i < entries.count(); i++) {
+            Private::Entry* entry = entries.at(i);
+            if (&entry->iPixmap == aPixmap) {
+                if (!--entry->iRefCount) {
+                    iPrivate->trim();
+                }
+                return;
+            }
+        }
+        HWARN("Releasing unknown dial plate" << (void*)aPixmap);
+    }
+}
+
+int
+ClockDialCache::hits() const
+{
+    QMutexLocker lock(&iPrivate->iMutex);
+    return iPrivate->iHits;
+}
+
+int
+ClockDialCache::misses() const
+{
+    QMutexLocker lock(&iPrivate->iMutex);
+    return iPrivate->iMisses;
+}
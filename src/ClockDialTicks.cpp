@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "ClockDialTicks.h"
+#include "ClockGeometryBuilder.h"
+
+ClockDialTicks::ClockDialTicks(
+    const QSize& aSize,
+    ClockRenderer* aRenderer)
+{
+    // Rotating the original transform (rather than the one rotated by
+    // the previous tick) doesn't accumulate rounding errors and keeps
+    // the ticks at multiples of 90 degrees perfectly axis-aligned
+    const QTransform center(QTransform::fromTranslate(aSize.width()/2.0,
+        aSize.height()/2.0));
+    iPolygons.reserve(TICK_COUNT);
+    for (int i = 0; i < TICK_COUNT; i++) {
+        const QPolygonF polygon(QTransform(center).rotate(i * 6.0).
+            map(QPolygonF(aRenderer->tickMarkRect(aSize, i))));
+        iPolygons.append(polygon);
+        iPath.addPolygon(polygon);
+    }
+}
+
+void
+ClockDialTicks::paint(
+    QPainter* aPainter,
+    const QColor& aColor) const
+{
+    aPainter->fillPath(iPath, aColor);
+}
+
+void
+ClockDialTicks::addTo(
+    ClockGeometryBuilder* aBuilder,
+    const QColor& aColor) const
+{
+    for (int i = 0; i < iPolygons.count(); i++) {
+        aBuilder->addConvexPolygon(iPolygons.at(i), aColor);
+    }
+}
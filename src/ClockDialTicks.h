@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef CLOCK_DIAL_TICKS_H
+#define CLOCK_DIAL_TICKS_H
+
+#include "ClockRenderer.h"
+
+#include <QVector>
+#include <QPolygonF>
+#include <QPainterPath>
+
+class ClockGeometryBuilder;
+
+// All 60 tick marks of the dial plate, in the item coordinates. They are
+// generated once per size (see ClockRenderer::dialTicks) and then filled
+// by QPainter in a single call or added to the scene graph geometry all
+// at once, rather than rotating the painter 60 times and rasterizing one
+// rotated rectangle at a time.
+class ClockDialTicks
+{
+public:
+    enum { TICK_COUNT = 60 };
+
+    ClockDialTicks(const QSize& aSize, ClockRenderer* aRenderer);
+
+    const QVector<QPolygonF>& polygons() const;
+    void paint(QPainter* aPainter, const QColor& aColor) const;
+    void addTo(ClockGeometryBuilder* aBuilder, const QColor& aColor) const;
+
+private:
+    QVector<QPolygonF> iPolygons;
+    QPainterPath iPath;
+};
+
+inline const QVector<QPolygonF>& ClockDialTicks::polygons() const
+    { return iPolygons; }
+
+#endif // CLOCK_DIAL_TICKS_H
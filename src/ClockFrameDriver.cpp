@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "ClockFrameDriver.h"
+#include "ClockDebug.h"
+
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QScreen>
+
+// Some platforms report zero or nonsense, fall back to the timer then
+#define MIN_REFRESH_RATE (20)
+#define MAX_REFRESH_RATE (250)
+
+// Anything longer than that is not a normal frame (e.g. the window has
+// just been exposed) and is ignored
+#define MAX_PRESENT_DELAY_US (100000)
+
+// Weight of the new sample in the moving average is 1/2^N
+#define PRESENT_DELAY_SHIFT (3)
+
+ClockFrameDriver::ClockFrameDriver(
+    QQuickItem* aItem) :
+    QObject(aItem),
+    iTimeSource(ClockTimeSource::sharedInstance()),
+    iSampleTime(-1)
+{
+    iClock.start();
+    connect(aItem, SIGNAL(windowChanged(QQuickWindow*)),
+        SLOT(onWindowChanged(QQuickWindow*)));
+    onWindowChanged(aItem->window());
+}
+
+void
+ClockFrameDriver::onWindowChanged(
+    QQuickWindow* aWindow)
+{
+    if (iWindow) {
+        iWindow->disconnect(this);
+    }
+    iWindow = aWindow;
+    if (aWindow) {
+        // frameSwapped is emitted on the render thread, the connection
+        // is queued in that case
+        connect(aWindow, SIGNAL(frameSwapped()), SLOT(onFrameSwapped()));
+        // And this one is called right after the swap
+        connect(aWindow, SIGNAL(frameSwapped()),
+            SLOT(onFrameSwappedDirect()), Qt::DirectConnection);
+        connect(aWindow, SIGNAL(screenChanged(QScreen*)),
+            SLOT(onScreenChanged(QScreen*)));
+        onScreenChanged(aWindow->screen());
+    } else {
+        onScreenChanged(NULL);
+    }
+}
+
+void
+ClockFrameDriver::onScreenChanged(
+    QScreen* aScreen)
+{
+    const qreal rate = aScreen ? aScreen->refreshRate() : 0;
+    if (rate >= MIN_REFRESH_RATE && rate <= MAX_REFRESH_RATE) {
+        HDEBUG("Refresh rate" << rate << "Hz");
+        iRefreshRate.store(qRound(rate));
+    } else {
+        HDEBUG("Unusable refresh rate" << rate);
+        iRefreshRate.store(0);
+    }
+}
+
+void
+ClockFrameDriver::requestFrame()
+{
+    iRequested.store(1);
+}
+
+void
+ClockFrameDriver::cancel()
+{
+    iRequested.store(0);
+}
+
+void
+ClockFrameDriver::onFrameSwapped()
+{
+    if (iRequested.testAndSetOrdered(1, 0)) {
+        Q_EMIT frame();
+    }
+}
+
+// Called on the render thread, or wherever the time gets sampled
+QTime
+ClockFrameDriver::presentTime()
+{
+    iSampleTime.store(iClock.nsecsElapsed());
+    return iTimeSource->currentTime().addMSecs(presentDelay());
+}
+
+void
+ClockFrameDriver::onFrameSwappedDirect()
+{
+    const qint64 sampled = iSampleTime.fetchAndStoreOrdered(-1);
+    if (sampled >= 0) {
+        const int delay = (int)((iClock.nsecsElapsed() - sampled) / 1000);
+        iPresentDelay.store(averagePresentDelay(iPresentDelay.load(), delay));
+    }
+}
+
+// Updates the moving average with a newly measured delay. Zero average
+// means that nothing has been measured yet. Delays which are too long
+// to be anything but a stall (e.g. the window was hidden) are ignored.
+int
+ClockFrameDriver::averagePresentDelay(
+    int aAverageUs,
+    int aDelayUs)
+{
+    if (aDelayUs > MAX_PRESENT_DELAY_US) {
+        return aAverageUs;
+    } else if (aAverageUs) {
+        return aAverageUs + ((aDelayUs - aAverageUs) >> PRESENT_DELAY_SHIFT);
+    } else {
+        return aDelayUs;
+    }
+}
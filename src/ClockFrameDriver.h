@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef CLOCK_FRAME_DRIVER_H
+#define CLOCK_FRAME_DRIVER_H
+
+#include "ClockTimeSource.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QTime>
+
+class QQuickItem;
+class QQuickWindow;
+class QScreen;
+
+// Drives the animation by the display refresh rather than by a timer.
+// The render loop throttles buffer swaps to vsync, so requesting the
+// next update when the previous frame has been swapped gives exactly
+// one update per refresh (50, 60, 90, 120 Hz, whatever the panel does)
+// without any timer wakeups in between.
+//
+// requestFrame() may be called from updatePaintNode() or paint(), i.e.
+// on the render thread. The frame() signal is emitted on the thread the
+// driver lives on.
+//
+// The driver also measures how long it takes from sampling the time to
+// the frameSwapped() signal, i.e. until the swap call returns on the
+// render thread. presentTime() adds the (smoothed) delay to the current
+// time, so that the hands are drawn closer to where they should be when
+// the frame is seen rather than where they were during the sync. That's
+// not the time of the scanout, which can't be observed from here. If
+// the compositor or the display adds another frame of latency, it's not
+// compensated for.
+class ClockFrameDriver : public QObject
+{
+    Q_OBJECT
+
+public:
+    ClockFrameDriver(QQuickItem* aItem);
+
+    bool isActive() const;
+    qreal refreshRate() const;
+    void requestFrame();
+    void cancel();
+    int presentDelay() const;
+    QTime presentTime();
+
+    static int averagePresentDelay(int aAverageUs, int aDelayUs);
+
+Q_SIGNALS:
+    void frame();
+
+private Q_SLOTS:
+    void onWindowChanged(QQuickWindow* aWindow);
+    void onScreenChanged(QScreen* aScreen);
+    void onFrameSwapped();
+    void onFrameSwappedDirect();
+
+private:
+    QSharedPointer<ClockTimeSource> iTimeSource;
+    QPointer<QQuickWindow> iWindow;
+    QAtomicInt iRequested;
+    QAtomicInt iRefreshRate; // Hz, zero if unknown or unusable
+    QElapsedTimer iClock;
+    QAtomicInteger<qint64> iSampleTime; // ns, negative if none
+    QAtomicInt iPresentDelay; // us, exponential moving average
+};
+
+inline bool ClockFrameDriver::isActive() const
+    { return iRefreshRate.load() > 0; }
+inline qreal ClockFrameDriver::refreshRate() const
+    { return iRefreshRate.load(); }
+inline int ClockFrameDriver::presentDelay() const
+    { return (iPresentDelay.load() + 500) / 1000; }
+
+#endif // CLOCK_FRAME_DRIVER_H
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "ClockFrameStats.h"
+#include "ClockDebug.h"
+
+#include <QQuickItem>
+#include <QQuickWindow>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define FRAME_STATS_ENV "CLOCK_FRAME_STATS"
+
+// Records closer than that belong to the same frame
+#define FRAME_GROUP_NS (1000000)
+
+// A frame arriving later than that after the expected time counts as
+// a missed deadline
+#define DEADLINE_SLACK_NS (4000000)
+
+// ==========================================================================
+// ClockFrameStats::Histogram
+// ==========================================================================
+
+int
+ClockFrameStats::Histogram::bucket(
+    qint64 aValue)
+{
+    if (aValue < SUB_BUCKETS) {
+        return qMax(aValue, qint64(0));
+    } else {
+        // Position of the most significant bit, at least 3
+        int e = 0;
+        for (qint64 v = aValue; v > 1; v >>= 1) e++;
+        const int i = (e - 2) * SUB_BUCKETS +
+            (int)((aValue >> (e - 3)) & (SUB_BUCKETS - 1));
+        return qMin(i, (int)BUCKETS - 1);
+    }
+}
+
+// The middle of the bucket
+qint64
+ClockFrameStats::Histogram::bucketValue(
+    int aBucket)
+{
+    if (aBucket < SUB_BUCKETS) {
+        return aBucket;
+    } else {
+        const int e = aBucket / SUB_BUCKETS + 2;
+        const qint64 width = Q_INT64_C(1) << (e - 3);
+        return (SUB_BUCKETS + aBucket % SUB_BUCKETS) * width + width / 2;
+    }
+}
+
+void
+ClockFrameStats::Histogram::add(
+    qint64 aValue)
+{
+    iBuckets[bucket(aValue)].ref();
+    iCount.ref();
+}
+
+int
+ClockFrameStats::Histogram::count() const
+{
+    return iCount.load();
+}
+
+qint64
+ClockFrameStats::Histogram::percentile(
+    int aPercent) const
+{
+    // The counters may be updated meanwhile, it's a snapshot anyway
+    const int n = iCount.load();
+    if (n > 0) {
+        // Nearest-rank method
+        const int rank = qMax((aPercent * n + 99) / 100, 1);
+        int total = 0;
+        for (int i = 0; i < BUCKETS; i++) {
+            total += iBuckets[i].load();
+            if (total >= rank) {
+                return bucketValue(i);
+            }
+        }
+    }
+    return 0;
+}
+
+qint64
+ClockFrameStats::Histogram::max() const
+{
+    for (int i = BUCKETS - 1; i >= 0; i--) {
+        if (iBuckets[i].load()) {
+            return bucketValue(i);
+        }
+    }
+    return 0;
+}
+
+// ==========================================================================
+// ClockFrameStats
+// ==========================================================================
+
+ClockFrameStats::ClockFrameStats(
+    QQuickItem* aItem,
+    int aPeriodSec) :
+    QObject(aItem),
+    iTimeSource(ClockTimeSource::sharedInstance()),
+    iScheduler(ClockScheduler::sharedInstance()),
+    iLastFrame(-1),
+    iDeadline(0),
+    iSecHandRenderer(NULL),
+    iSecHandAngle(0),
+    iTimeErrorSum(0)
+{
+    iClock.start();
+    if (aPeriodSec > 0) {
+        iDumpTimer.start(aPeriodSec * 1000, this);
+    }
+    connect(aItem, SIGNAL(windowChanged(QQuickWindow*)),
+        SLOT(onWindowChanged(QQuickWindow*)));
+    onWindowChanged(aItem->window());
+}
+
+ClockFrameStats::~ClockFrameStats()
+{
+    dump();
+}
+
+// Returns NULL unless enabled by the environment
+ClockFrameStats*
+ClockFrameStats::create(
+    QQuickItem* aItem)
+{
+    const char* env = getenv(FRAME_STATS_ENV);
+    return env ? new ClockFrameStats(aItem, atoi(env)) : NULL;
+}
+
+void
+ClockFrameStats::onWindowChanged(
+    QQuickWindow* aWindow)
+{
+    if (iWindow) {
+        iWindow->disconnect(this);
+    }
+    iWindow = aWindow;
+    if (aWindow) {
+        // Direct connection, to get the swap time right
+        connect(aWindow, SIGNAL(frameSwapped()), SLOT(onFrameSwapped()),
+            Qt::DirectConnection);
+    }
+}
+
+void
+ClockFrameStats::setName(
+    const QString& aName)
+{
+    iName = aName;
+}
+
+void
+ClockFrameStats::recordFrame(
+    qint64 aStart,
+    int aNextFrameMs)
+{
+    const qint64 last = iLastFrame.load();
+    const qint64 deadline = (aNextFrameMs > 0) ?
+        (aStart + qint64(aNextFrameMs) * 1000000) : 0;
+    iDuration.add((now() - aStart) / 1000);
+    if (last >= 0 && aStart - last < FRAME_GROUP_NS) {
+        // Another part of the same frame, the earliest deadline wins
+        const qint64 prev = iDeadline.load();
+        if (deadline > 0 && (!prev || deadline < prev)) {
+            iDeadline.store(deadline);
+        }
+    } else {
+        if (last >= 0) {
+            const qint64 prev = iDeadline.load();
+            iInterval.add((aStart - last) / 1000);
+            if (prev > 0 && aStart > prev + DEADLINE_SLACK_NS) {
+                iMissedDeadlines.ref();
+            }
+        }
+        iLastFrame.store(aStart);
+        iDeadline.store(deadline);
+    }
+}
+
+void
+ClockFrameStats::recordSecHand(
+    ClockRenderer* aRenderer,
+    qreal aAngle,
+    const QTime& aTime)
+{
+    iSecHandRenderer = aRenderer;
+    iSecHandAngle = aAngle;
+    iSecHandTime = aTime;
+}
+
+void
+ClockFrameStats::recordWakeup(
+    bool aSuspended)
+{
+    iWakeups.ref();
+    if (aSuspended) iSuspendedWakeups.ref();
+}
+
+void
+ClockFrameStats::recordRender(
+    bool aSuspended)
+{
+    if (aSuspended) iSuspendedRenders.ref();
+}
+
+void
+ClockFrameStats::onFrameSwapped()
+{
+    if (iSecHandRenderer) {
+        const QTime now(iTimeSource->currentTime());
+        const qreal angle = iSecHandRenderer->nodeAngle(
+            ClockRenderer::NodeSec, now);
+        qreal diff = angle - iSecHandAngle;
+        int ms = iSecHandTime.msecsTo(now);
+
+        // Wrap around the top of the dial and around midnight
+        while (diff > 180) diff -= 360;
+        while (diff < -180) diff += 360;
+        if (ms < -43200000) ms += 86400000;
+
+        iAngleError.add(qRound(qAbs(diff) * 1000));
+        iTimeError.add(qint64(qAbs(ms)) * 1000);
+        iTimeErrorSum.fetchAndAddRelaxed(ms);
+        if (ms < 0) iAhead.ref();
+        iSecHandRenderer = NULL;
+    }
+}
+
+void
+ClockFrameStats::dump()
+{
+    const QByteArray name(iName.toUtf8());
+    fprintf(stderr, "%s: %d frames (%d renders), interval p50/p95/p99 %.2f/%.2f/%.2f ms, "
+        "render p50/p95/p99 %.2f/%.2f/%.2f ms, %d missed deadlines\n",
+        name.constData(), iDuration.count() ? (iInterval.count() + 1) : 0,
+        iDuration.count(),
+        iInterval.percentile(50)/1000.0, iInterval.percentile(95)/1000.0,
+        iInterval.percentile(99)/1000.0, iDuration.percentile(50)/1000.0,
+        iDuration.percentile(95)/1000.0, iDuration.percentile(99)/1000.0,
+        iMissedDeadlines.load());
+    const int n = iTimeError.count();
+    if (n > 0) {
+        fprintf(stderr, "%s: second hand error p50/p95/p99/max "
+            "%.3f/%.3f/%.3f/%.3f deg, %.1f/%.1f/%.1f/%.1f ms, "
+            "mean lag %.1f ms, %d of %d frames ahead\n", name.constData(),
+            iAngleError.percentile(50)/1000.0,
+            iAngleError.percentile(95)/1000.0,
+            iAngleError.percentile(99)/1000.0, iAngleError.max()/1000.0,
+            iTimeError.percentile(50)/1000.0, iTimeError.percentile(95)/1000.0,
+            iTimeError.percentile(99)/1000.0, iTimeError.max()/1000.0,
+            double(iTimeErrorSum.load())/n, iAhead.load(), n);
+    }
+    fprintf(stderr, "%s: %d wakeups, %d wakeups and %d renders while "
+        "suspended, %d scheduler wakeups in the last minute\n",
+        name.constData(), iWakeups.load(), iSuspendedWakeups.load(),
+        iSuspendedRenders.load(), iScheduler->wakeupsPerMinute());
+    fflush(stderr);
+}
+
+void
+ClockFrameStats::timerEvent(
+    QTimerEvent* aEvent)
+{
+    if (aEvent->timerId() == iDumpTimer.timerId()) {
+        dump();
+    } else {
+        QObject::timerEvent(aEvent);
+    }
+}
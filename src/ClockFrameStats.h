@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef CLOCK_FRAME_STATS_H
+#define CLOCK_FRAME_STATS_H
+
+#include "ClockRenderer.h"
+#include "ClockScheduler.h"
+#include "ClockTimeSource.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QTime>
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QBasicTimer>
+#include <QElapsedTimer>
+
+class QQuickItem;
+class QQuickWindow;
+
+// Frame statistics of a single clock, available in release builds too.
+// Enabled by the CLOCK_FRAME_STATS environment variable, which may also
+// specify how often (in seconds) the stats are dumped to stderr. They
+// are always dumped when the clock goes away.
+//
+// Frames may be recorded on the render thread, so recording is lock-free.
+// Records made less than FRAME_GROUP_NS apart (e.g. the layers of the
+// same clock updated during the same sync) belong to the same frame.
+//
+// The second hand angle recorded during the sync is compared against the
+// correct angle for the time when the frame gets swapped, which gives the
+// error that's actually seen on the screen. Both recordSecHand() and the
+// frameSwapped() handler run on the render thread.
+class ClockFrameStats : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Values are in microseconds. Each power of two is split into 8
+    // buckets, so the error is under 12.5%.
+    class Histogram {
+    public:
+        enum { SUB_BUCKETS = 8, BUCKETS = 28 * SUB_BUCKETS };
+        void add(qint64 aValue);
+        int count() const;
+        qint64 percentile(int aPercent) const;
+        qint64 max() const;
+    private:
+        static int bucket(qint64 aValue);
+        static qint64 bucketValue(int aBucket);
+    private:
+        QAtomicInt iCount;
+        QAtomicInt iBuckets[BUCKETS];
+    };
+
+    static ClockFrameStats* create(QQuickItem* aItem);
+    ~ClockFrameStats();
+
+    void setName(const QString& aName);
+    qint64 now() const;
+
+    // aStart is what now() returned when rendering started. aNextFrameMs
+    // is when the next frame is due, zero or negative if there's no
+    // particular deadline.
+    void recordFrame(qint64 aStart, int aNextFrameMs);
+    void recordSecHand(ClockRenderer* aRenderer, qreal aAngle,
+        const QTime& aTime);
+    // Timer wakeups and renders, aSuspended while updates are disabled
+    // (there shouldn't be any)
+    void recordWakeup(bool aSuspended);
+    void recordRender(bool aSuspended);
+    void dump();
+
+protected:
+    void timerEvent(QTimerEvent* aEvent) Q_DECL_OVERRIDE;
+
+private Q_SLOTS:
+    void onWindowChanged(QQuickWindow* aWindow);
+    void onFrameSwapped();
+
+private:
+    ClockFrameStats(QQuickItem* aItem, int aPeriodSec);
+
+private:
+    QSharedPointer<ClockTimeSource> iTimeSource;
+    QSharedPointer<ClockScheduler> iScheduler;
+    QElapsedTimer iClock;
+    QBasicTimer iDumpTimer;
+    QString iName;
+    QAtomicInteger<qint64> iLastFrame;
+    QAtomicInteger<qint64> iDeadline;
+    QAtomicInt iMissedDeadlines;
+    Histogram iInterval;
+    Histogram iDuration;
+    QPointer<QQuickWindow> iWindow;
+    // Render thread only
+    ClockRenderer* iSecHandRenderer;
+    qreal iSecHandAngle;
+    QTime iSecHandTime;
+    // Millidegrees and microseconds
+    Histogram iAngleError;
+    Histogram iTimeError;
+    QAtomicInteger<qint64> iTimeErrorSum;
+    QAtomicInt iAhead;
+    QAtomicInt iWakeups;
+    QAtomicInt iSuspendedWakeups;
+    QAtomicInt iSuspendedRenders;
+};
+
+inline qint64 ClockFrameStats::now() const
+    { return iClock.nsecsElapsed(); }
+
+#endif // CLOCK_FRAME_STATS_H
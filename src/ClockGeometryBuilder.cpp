@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "ClockGeometryBuilder.h"
+
+#include <QSGVertexColorMaterial>
+
+// Limits the length of the miter at sharp corners
+#define MIN_MITER_COS (0.25)
+
+ClockGeometryBuilder::ClockGeometryBuilder(
+    qreal aFeather) :
+    iFeather(qMax(aFeather, qreal(0)))
+{
+}
+
+// Scales premultiplied color
+static inline QRgb
+fade(
+    QRgb aColor,
+    qreal aOpacity)
+{
+    return qRgba(qRound(qRed(aColor) * aOpacity),
+        qRound(qGreen(aColor) * aOpacity),
+        qRound(qBlue(aColor) * aOpacity),
+        qRound(qAlpha(aColor) * aOpacity));
+}
+
+inline void
+ClockGeometryBuilder::addVertex(
+    const QPointF& aPoint,
+    QRgb aColor)
+{
+    QSGGeometry::ColoredPoint2D v;
+    v.set(aPoint.x(), aPoint.y(), qRed(aColor), qGreen(aColor),
+        qBlue(aColor), qAlpha(aColor));
+    iVertices.append(v);
+}
+
+inline void
+ClockGeometryBuilder::addTriangle(
+    const QPointF& aPoint1,
+    QRgb aColor1,
+    const QPointF& aPoint2,
+    QRgb aColor2,
+    const QPointF& aPoint3,
+    QRgb aColor3)
+{
+    addVertex(aPoint1, aColor1);
+    addVertex(aPoint2, aColor2);
+    addVertex(aPoint3, aColor3);
+}
+
+void
+ClockGeometryBuilder::addFan(
+    const QPolygonF& aPolygon,
+    QRgb aColor)
+{
+    const int n = aPolygon.count();
+    for (int i = 1; i + 1 < n; i++) {
+        addTriangle(aPolygon.at(0), aColor, aPolygon.at(i), aColor,
+            aPolygon.at(i+1), aColor);
+    }
+}
+
+void
+ClockGeometryBuilder::addRect(
+    const QRectF& aRect,
+    const QColor& aColor)
+{
+    QPolygonF polygon;
+    polygon.reserve(4);
+    polygon.append(aRect.topLeft());
+    polygon.append(aRect.bottomLeft());
+    polygon.append(aRect.bottomRight());
+    polygon.append(aRect.topRight());
+    addConvexPolygon(polygon, aColor);
+}
+
+void
+ClockGeometryBuilder::addConvexPolygon(
+    const QPolygonF& aPolygon,
+    const QColor& aColor)
+{
+    // Drop repeated points, including the closing one
+    QPolygonF p;
+    p.reserve(aPolygon.count());
+    for (int i = 0; i < aPolygon.count(); i++) {
+        if (p.isEmpty() || p.last() != aPolygon.at(i)) {
+            p.append(aPolygon.at(i));
+        }
+    }
+    if (p.count() > 1 && p.first() == p.last()) {
+        p.removeLast();
+    }
+
+    const int n = p.count();
+    if (n >= 3) {
+        // QSGVertexColorMaterial expects premultiplied colors
+        const QRgb c = qPremultiply(aColor.rgba());
+        if (iFeather > 0) {
+            // Outward normals of the edges
+            QPointF center(0, 0);
+            for (int i = 0; i < n; i++) {
+                center += p.at(i);
+            }
+            center /= n;
+            QVector<QPointF> normals;
+            normals.reserve(n);
+            for (int i = 0; i < n; i++) {
+                const QPointF& p1 = p.at(i);
+                const QPointF& p2 = p.at((i + 1) % n);
+                const QPointF d(p2 - p1);
+                QPointF normal(d.y(), -d.x());
+                normal /= sqrt(QPointF::dotProduct(normal, normal));
+                if (QPointF::dotProduct(normal, (p1 + p2)/2 - center) < 0) {
+                    normal = -normal;
+                }
+                normals.append(normal);
+            }
+
+            // Shift the vertices inside and outside along the miter
+            const qreal half = iFeather/2;
+            QPolygonF inner, outer;
+            inner.reserve(n);
+            outer.reserve(n);
+            for (int i = 0; i < n; i++) {
+                const QPointF& n1 = normals.at((i + n - 1) % n);
+                const QPointF& n2 = normals.at(i);
+                const qreal k = qMax(1 + QPointF::dotProduct(n1, n2),
+                    qreal(MIN_MITER_COS));
+                const QPointF miter((n1 + n2) * (half / k));
+                inner.append(p.at(i) - miter);
+                outer.append(p.at(i) + miter);
+            }
+
+            iVertices.reserve(iVertices.count() + 3*(n-2) + 6*n);
+            addFan(inner, c);
+            for (int i = 0; i < n; i++) {
+                const int j = (i + 1) % n;
+                addTriangle(inner.at(i), c, inner.at(j), c, outer.at(j), 0);
+                addTriangle(inner.at(i), c, outer.at(j), 0, outer.at(i), 0);
+            }
+        } else {
+            iVertices.reserve(iVertices.count() + 3*(n-2));
+            addFan(p, c);
+        }
+    }
+}
+
+void
+ClockGeometryBuilder::addCircle(
+    const QPointF& aCenter,
+    qreal aRadius,
+    const QColor& aColor)
+{
+    const int n = ClockRenderer::circleSegments(aRadius);
+    const QSGGeometry::Point2D* u = ClockRenderer::unitCircle(n);
+    QPolygonF polygon;
+    polygon.reserve(n);
+    for (int i = 0; i < n; i++) {
+        polygon.append(QPointF(aCenter.x() + aRadius * u[i].x,
+            aCenter.y() + aRadius * u[i].y));
+    }
+    addConvexPolygon(polygon, aColor);
+}
+
+// Area between two concentric circles, the color changes from aColor1
+// on the first circle to aColor2 on the second one. All bands of the
+// same ring use the same number of segments, to avoid cracks between
+// them.
+void
+ClockGeometryBuilder::addBand(
+    const QPointF& aCenter,
+    int aSegments,
+    qreal aRadius1,
+    QRgb aColor1,
+    qreal aRadius2,
+    QRgb aColor2)
+{
+    const int n = aSegments;
+    const QSGGeometry::Point2D* u = ClockRenderer::unitCircle(n);
+    const qreal r1 = qMax(aRadius1, qreal(0));
+    const qreal r2 = qMax(aRadius2, qreal(0));
+    iVertices.reserve(iVertices.count() + 6*n);
+    for (int i = 0; i < n; i++) {
+        const QPointF u1(u[i].x, u[i].y);
+        const QPointF u2(u[i+1].x, u[i+1].y);
+        const QPointF p11(aCenter + u1 * r1);
+        const QPointF p12(aCenter + u2 * r1);
+        const QPointF p21(aCenter + u1 * r2);
+        const QPointF p22(aCenter + u2 * r2);
+        addTriangle(p11, aColor1, p12, aColor1, p22, aColor2);
+        addTriangle(p11, aColor1, p22, aColor2, p21, aColor2);
+    }
+}
+
+void
+ClockGeometryBuilder::addRing(
+    const QPointF& aCenter,
+    qreal aRadius,
+    qreal aThickness,
+    const QColor& aColor)
+{
+    const QRgb c = qPremultiply(aColor.rgba());
+    const qreal r1 = aRadius - qMin(aRadius, aThickness);
+    const qreal r2 = aRadius;
+    if (iFeather <= 0) {
+        addBand(aCenter, ClockRenderer::circleSegments(r2), r1, c, r2, c);
+    } else {
+        const qreal half = iFeather/2;
+        const int n = ClockRenderer::circleSegments(r2 + half);
+        if (r2 - r1 > iFeather) {
+            addBand(aCenter, n, r1 - half, 0, r1 + half, c);
+            addBand(aCenter, n, r1 + half, c, r2 - half, c);
+            addBand(aCenter, n, r2 - half, c, r2 + half, 0);
+        } else {
+            // Too thin to be fully opaque anywhere
+            const qreal r = (r1 + r2)/2;
+            const QRgb cr = fade(c, (r2 - r1)/iFeather);
+            addBand(aCenter, n, r - half, 0, r, cr);
+            addBand(aCenter, n, r, cr, r + half, 0);
+        }
+    }
+}
+
+QSGGeometry*
+ClockGeometryBuilder::geometry() const
+{
+    const int n = iVertices.count();
+    QSGGeometry* g = new QSGGeometry(
+        QSGGeometry::defaultAttributes_ColoredPoint2D(), n);
+    g->setDrawingMode(GL_TRIANGLES);
+    memcpy(g->vertexDataAsColoredPoint2D(), iVertices.constData(),
+        n * sizeof(QSGGeometry::ColoredPoint2D));
+    return g;
+}
+
+QSGGeometryNode*
+ClockGeometryBuilder::node() const
+{
+    QSGGeometryNode* node = new QSGGeometryNode;
+    node->setGeometry(geometry());
+    node->setMaterial(new QSGVertexColorMaterial);
+    node->setFlag(QSGNode::OwnsGeometry);
+    node->setFlag(QSGNode::OwnsMaterial);
+    return node;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef CLOCK_GEOMETRY_BUILDER_H
+#define CLOCK_GEOMETRY_BUILDER_H
+
+#include "ClockRenderer.h"
+
+#include <QColor>
+#include <QVector>
+#include <QPolygonF>
+#include <QSGGeometryNode>
+
+// Collects triangles of different colors into a single geometry with
+// per-vertex colors, so that e.g. a hand together with its shadows can
+// be rendered by a single node with a single material. Shapes are drawn
+// in the order they were added.
+//
+// Unless the feather width is zero, the edges of each shape fade out
+// from fully opaque to fully transparent over that distance (centered
+// at the actual edge), the same way Qt antialiases rectangle nodes.
+// That makes multisampling unnecessary.
+class ClockGeometryBuilder
+{
+public:
+    ClockGeometryBuilder(qreal aFeather = 0);
+
+    void addRect(const QRectF& aRect, const QColor& aColor);
+    void addConvexPolygon(const QPolygonF& aPolygon, const QColor& aColor);
+    void addCircle(const QPointF& aCenter, qreal aRadius,
+        const QColor& aColor);
+    void addRing(const QPointF& aCenter, qreal aRadius, qreal aThickness,
+        const QColor& aColor);
+
+    bool isEmpty() const;
+    int vertexCount() const;
+    QSGGeometry* geometry() const;
+    QSGGeometryNode* node() const;
+
+private:
+    void addVertex(const QPointF& aPoint, QRgb aPremultipliedColor);
+    void addTriangle(const QPointF& aPoint1, QRgb aColor1,
+        const QPointF& aPoint2, QRgb aColor2,
+        const QPointF& aPoint3, QRgb aColor3);
+    void addFan(const QPolygonF& aPolygon, QRgb aColor);
+    void addBand(const QPointF& aCenter, int aSegments, qreal aRadius1,
+        QRgb aColor1, qreal aRadius2, QRgb aColor2);
+
+private:
+    const qreal iFeather;
+    QVector<QSGGeometry::ColoredPoint2D> iVertices;
+};
+
+inline bool ClockGeometryBuilder::isEmpty() const
+    { return iVertices.isEmpty(); }
+inline int ClockGeometryBuilder::vertexCount() const
+    { return iVertices.count(); }
+
+#endif // CLOCK_GEOMETRY_BUILDER_H
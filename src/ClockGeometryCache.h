@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef CLOCK_GEOMETRY_CACHE_H
+#define CLOCK_GEOMETRY_CACHE_H
+
+#include <QSize>
+#include <QList>
+#include <QPair>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
+
+// Small thread-safe LRU cache of objects derived from the clock size.
+// Renderers are shared by all clocks (which may have different sizes and
+// may be rendered on different threads), so they can't keep such things
+// in their own member variables. Returned objects stay valid even if they
+// get evicted from the cache while still being used.
+template <class T>
+class ClockGeometryCache
+{
+public:
+    enum { DEFAULT_CAPACITY = 4 };
+
+    ClockGeometryCache(int aCapacity = DEFAULT_CAPACITY) :
+        iCapacity(aCapacity) {}
+
+    // Creates new T(aSize, aArg) if necessary. The argument is supposed
+    // to be the same for all calls.
+    template <class A>
+    QSharedPointer<const T> get(const QSize& aSize, A aArg);
+
+private:
+    typedef QPair<QSize, QSharedPointer<const T> > Entry;
+    const int iCapacity;
+    QMutex iMutex;
+    QList<Entry> iEntries; // Most recently used first
+};
+
+template <class T>
+template <class A>
+QSharedPointer<const T>
+ClockGeometryCache<T>::get(
+    const QSize& aSize,
+    A aArg)
+{
+    QMutexLocker lock(&iMutex);
+    for (int i = 0; i < iEntries.count(); i++) {
+        if (iEntries.at(i).first == aSize) {
+            if (i > 0) iEntries.move(i, 0);
+            return iEntries.first().second;
+        }
+    }
+    QSharedPointer<const T> object(new T(aSize, aArg));
+    iEntries.insert(0, Entry(aSize, object));
+    while (iEntries.count() > iCapacity) {
+        iEntries.removeLast();
+    }
+    return object;
+}
+
+#endif // CLOCK_GEOMETRY_CACHE_H
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "ClockHourMinLayer.h"
+#include "ClockDebug.h"
+
+ClockHourMinLayer::ClockHourMinLayer() :
+    iPixmap(NULL),
+    iRenderer(NULL),
+    iTheme(NULL),
+    iDialPlate(NULL),
+    iHourAngle(0),
+    iMinAngle(0),
+    iUpdateCount(0)
+{
+}
+
+ClockHourMinLayer::~ClockHourMinLayer()
+{
+    delete iPixmap;
+}
+
+void
+ClockHourMinLayer::invalidate()
+{
+    // The pixmap itself is kept, it will most likely be reused
+    iRenderer = NULL;
+}
+
+void
+ClockHourMinLayer::release()
+{
+    // Frees the memory, e.g. when switching to the scene graph
+    invalidate();
+    delete iPixmap;
+    iPixmap = NULL;
+}
+
+bool
+ClockHourMinLayer::isValid(
+    ClockRenderer* aRenderer,
+    const QSize& aSize,
+    const QTime& aTime) const
+{
+    // Comparing the angles (rather than hours and minutes) handles the
+    // minute hand animation and whatever else the renderer might do
+    return iRenderer == aRenderer && iPixmap && iPixmap->size() == aSize &&
+        aRenderer->nodeAngle(ClockRenderer::NodeMin, aTime) == iMinAngle &&
+        aRenderer->nodeAngle(ClockRenderer::NodeHour, aTime) == iHourAngle;
+}
+
+bool
+ClockHourMinLayer::update(
+    ClockRenderer* aRenderer,
+    ClockTheme* aTheme,
+    const QPixmap* aDialPlate,
+    const QSize& aSize,
+    const QTime& aTime)
+{
+    if (iTheme == aTheme && iDialPlate == aDialPlate &&
+        isValid(aRenderer, aSize, aTime)) {
+        return false;
+    }
+
+    if (!iPixmap || iPixmap->size() != aSize) {
+        delete iPixmap;
+        iPixmap = new QPixmap(aSize);
+    }
+
+    QVERBOSE("- drawing hour and minute hands" <<
+        qPrintable(aTime.toString("hh:mm:ss.zzz")));
+    iRenderer = aRenderer;
+    iTheme = aTheme;
+    iDialPlate = aDialPlate;
+    iHourAngle = aRenderer->nodeAngle(ClockRenderer::NodeHour, aTime);
+    iMinAngle = aRenderer->nodeAngle(ClockRenderer::NodeMin, aTime);
+    iUpdateCount++;
+
+    iPixmap->fill(Qt::transparent);
+    QPainter painter(iPixmap);
+    if (aDialPlate) {
+        painter.drawPixmap(0, 0, *aDialPlate);
+    }
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setRenderHint(QPainter::HighQualityAntialiasing);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    aRenderer->paintHourMinHands(&painter, aSize, aTime, aTheme);
+    return true;
+}
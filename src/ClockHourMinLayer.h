@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef CLOCK_HOUR_MIN_LAYER_H
+#define CLOCK_HOUR_MIN_LAYER_H
+
+#include "ClockRenderer.h"
+
+#include <QPixmap>
+
+// Dial plate with hour and minute hands, used by the raster (non-optimized)
+// rendering path underneath the second hand. It's redrawn only when one
+// of the hands actually moves, i.e. once a minute plus every frame during
+// the minute hand animation at the top of the minute.
+class ClockHourMinLayer
+{
+public:
+    ClockHourMinLayer();
+    ~ClockHourMinLayer();
+
+    void invalidate();
+    void release();
+    bool isValid(ClockRenderer* aRenderer, const QSize& aSize,
+        const QTime& aTime) const;
+
+    // Returns true if the layer had to be redrawn
+    bool update(ClockRenderer* aRenderer, ClockTheme* aTheme,
+        const QPixmap* aDialPlate, const QSize& aSize, const QTime& aTime);
+
+    const QPixmap* pixmap() const;
+    int updateCount() const;
+
+private:
+    QPixmap* iPixmap;
+    ClockRenderer* iRenderer;
+    ClockTheme* iTheme;
+    const QPixmap* iDialPlate;
+    qreal iHourAngle;
+    qreal iMinAngle;
+    int iUpdateCount;
+};
+
+inline const QPixmap* ClockHourMinLayer::pixmap() const
+    { return iPixmap; }
+inline int ClockHourMinLayer::updateCount() const
+    { return iUpdateCount; }
+
+#endif // CLOCK_HOUR_MIN_LAYER_H
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "ClockMotionProfile.h"
+
+#include <qmath.h>
+
+// Doesn't move
+ClockMotionProfile::ClockMotionProfile() :
+    iPeriod(1),
+    iMove(0),
+    iStep(0),
+    iBase(0)
+{
+}
+
+// aFunction gets the time since the start of the period, [0, aMoveMs]
+// and returns the fraction of the step done by then, 0 at the start and
+// (close to) 1 at the end. With aBase -1, the step leads from the
+// previous position to the current one, otherwise from the current to
+// the next.
+ClockMotionProfile::ClockMotionProfile(
+    int aPeriodMs,
+    int aMoveMs,
+    qreal aStep,
+    qreal aBase,
+    Function aFunction) :
+    iPeriod(aPeriodMs),
+    iMove(qBound(1, aMoveMs, aPeriodMs)),
+    iStep(aStep),
+    iBase(aBase)
+{
+    iTable.resize(TABLE_SIZE + 1);
+    qreal* table = iTable.data();
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        table[i] = aFunction((qreal)i * iMove / TABLE_SIZE, iMove);
+    }
+    // The motion ends exactly at the next position
+    table[TABLE_SIZE] = 1;
+}
+
+qreal
+ClockMotionProfile::linear(
+    qreal aMs,
+    int aMoveMs)
+{
+    return aMs / aMoveMs;
+}
+
+// The minute hand of the Swiss railway clock
+qreal
+ClockMotionProfile::damped(
+    qreal aMs,
+    int)
+{
+    const qreal x = aMs / 222.0;
+    return 1 - qExp(-1.5 * x) * qCos(2 * M_PI * x);
+}
+
+ClockMotionProfile
+ClockMotionProfile::sweep(
+    int aPeriodMs,
+    qreal aStep)
+{
+    return stopToGo(aPeriodMs, aPeriodMs, aStep);
+}
+
+ClockMotionProfile
+ClockMotionProfile::stopToGo(
+    int aPeriodMs,
+    int aMoveMs,
+    qreal aStep)
+{
+    return ClockMotionProfile(aPeriodMs, aMoveMs, aStep, 0, linear);
+}
+
+ClockMotionProfile
+ClockMotionProfile::tick(
+    int aPeriodMs,
+    int aMoveMs,
+    qreal aStep)
+{
+    return ClockMotionProfile(aPeriodMs, aMoveMs, aStep, -1, linear);
+}
+
+ClockMotionProfile
+ClockMotionProfile::bounce(
+    int aPeriodMs,
+    int aMoveMs,
+    qreal aStep)
+{
+    return ClockMotionProfile(aPeriodMs, aMoveMs, aStep, -1, damped);
+}
+
+// Fraction of the step done aMs since the start of the period
+inline qreal
+ClockMotionProfile::progress(
+    int aMs) const
+{
+    if (aMs >= iMove) {
+        return 1;
+    } else {
+        const qreal x = (qreal)aMs * TABLE_SIZE / iMove;
+        const int i = (int)x;
+        const qreal* table = iTable.constData();
+        return table[i] + (table[i + 1] - table[i]) * (x - i);
+    }
+}
+
+qreal
+ClockMotionProfile::angle(
+    const QTime& aTime) const
+{
+    const int ms = aTime.msecsSinceStartOfDay();
+    const qreal a = iStep * ((ms / iPeriod) + iBase +
+        progress(ms % iPeriod));
+    return a - 360 * qFloor(a / 360);
+}
+
+int
+ClockMotionProfile::msecUntilMove(
+    const QTime& aTime) const
+{
+    if (iStep) {
+        const int t = aTime.msecsSinceStartOfDay() % iPeriod;
+        return (t < iMove) ? 0 : (iPeriod - t);
+    } else {
+        return -1;
+    }
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef CLOCK_MOTION_PROFILE_H
+#define CLOCK_MOTION_PROFILE_H
+
+#include <QTime>
+#include <QVector>
+
+// How a hand moves. Every aPeriodMs the hand advances by aStep degrees,
+// moving during the first aMoveMs of the period and standing still for
+// the rest of it. The shape of the motion is precomputed into a table,
+// so evaluating it takes a lookup and a linear interpolation no matter
+// how expensive the original function is.
+//
+//   sweep     - moves all the time at a constant speed
+//   stopToGo  - sweeps the step in aMoveMs, then waits for the next
+//               period (the Swiss second hand)
+//   tick      - jumps to the next position at the start of the period,
+//               the jump takes aMoveMs
+//   bounce    - the same, but overshoots and settles (the Swiss minute
+//               hand)
+//
+// Periods must divide the day, the angle is calculated from the time of
+// day.
+class ClockMotionProfile
+{
+public:
+    ClockMotionProfile();
+
+    static ClockMotionProfile sweep(int aPeriodMs, qreal aStep);
+    static ClockMotionProfile stopToGo(int aPeriodMs, int aMoveMs,
+        qreal aStep);
+    static ClockMotionProfile tick(int aPeriodMs, int aMoveMs, qreal aStep);
+    static ClockMotionProfile bounce(int aPeriodMs, int aMoveMs, qreal aStep);
+
+    // Angle in degrees, [0, 360)
+    qreal angle(const QTime& aTime) const;
+
+    // Zero while the hand is moving, otherwise the time until it starts
+    // moving again. Negative if it never moves.
+    int msecUntilMove(const QTime& aTime) const;
+
+    int period() const;
+    int moveTime() const;
+
+private:
+    enum { TABLE_SIZE = 256 };
+    typedef qreal (*Function)(qreal aMs, int aMoveMs);
+    ClockMotionProfile(int aPeriodMs, int aMoveMs, qreal aStep,
+        qreal aBase, Function aFunction);
+    static qreal linear(qreal aMs, int aMoveMs);
+    static qreal damped(qreal aMs, int aMoveMs);
+    qreal progress(int aMs) const;
+
+private:
+    int iPeriod;
+    int iMove;
+    qreal iStep;
+    qreal iBase;
+    QVector<qreal> iTable;
+};
+
+inline int ClockMotionProfile::period() const
+    { return iPeriod; }
+inline int ClockMotionProfile::moveTime() const
+    { return iMove; }
+
+#endif // CLOCK_MOTION_PROFILE_H
@@ -32,12 +32,21 @@
  */
 
 #include "ClockRenderer.h"
+#include "ClockDialTicks.h"
+#include "ClockGeometryBuilder.h"
 #include "ClockDebug.h"
 
 #include <qmath.h>
+#include <QMutex>
+#include <QOpenGLContext>
 #include <QSGSimpleTextureNode>
 #include <QSGFlatColorMaterial>
 
+// Maximum distance between the arc and the chord, in pixels
+#define CIRCLE_TOLERANCE        (0.25)
+#define CIRCLE_MIN_SEGMENTS     (8)
+#define CIRCLE_MAX_SEGMENTS     (256)
+
 class ClockRenderer::ImageNode: public QSGSimpleTextureNode {
 public:
     ImageNode(QQuickWindow* aWindow, qreal aX, qreal aY, QImage aImage);
@@ -59,24 +68,64 @@ ClockRenderer::ImageNode::~ImageNode()
     delete texture();
 }
 
+// By default the second hand sweeps, the hour and minute hands move
+// once a minute, taking a second to do so
+ClockRenderer::ClockRenderer(
+    QString aId) :
+    iId(aId)
+{
+    iMotionProfile[NodeHour] = ClockMotionProfile::tick(60000, 1000, 0.5);
+    iMotionProfile[NodeMin] = ClockMotionProfile::tick(60000, 1000, 6);
+    iMotionProfile[NodeSec] = ClockMotionProfile::sweep(60000, 360);
+}
+
 ClockRenderer::~ClockRenderer()
 {
 }
 
+void
+ClockRenderer::setMotionProfile(
+    NodeType aType,
+    const ClockMotionProfile& aProfile)
+{
+    if (aType != NodeDial) {
+        iMotionProfile[aType] = aProfile;
+    }
+}
+
+QList<ClockRenderer*>
+ClockRenderer::all()
+{
+    QList<ClockRenderer*> renderers;
+    renderers.append(swissRailroad());
+    renderers.append(helsinkiMetro());
+    renderers.append(deutscheBahn());
+    return renderers;
+}
+
+ClockRenderer*
+ClockRenderer::find(
+    const QString& aId)
+{
+    const QList<ClockRenderer*> renderers(all());
+    for (int i = 0; i < renderers.count(); i++) {
+        ClockRenderer* renderer = renderers.at(i);
+        if (renderer->id() == aId) {
+            return renderer;
+        }
+    }
+    return NULL;
+}
+
 int
 ClockRenderer::msecUntilNextUpdate(
     NodeType aType,
     const QTime& aTime)
 {
-    if (aType == NodeSec || aTime.second() == 0) {
-        return QUICK_CLOCK_MIN_UPDATE_INTERVAL;
-    } else {
-        // 59 seconds out of 60 hour and minute handls are not changing
-        // positions. Make this timer fire one second eariler so that we
-        // could aim better.
-        const int msec = ((58 - aTime.second()) * 1000) + 1000 - aTime.msec();
-        return qMax(msec, QUICK_CLOCK_MIN_UPDATE_INTERVAL);
-    }
+    // While the hand is moving, as often as possible. Otherwise wake up
+    // when it starts moving again, e.g. at the top of the minute.
+    const int msec = motionProfile(aType).msecUntilMove(aTime);
+    return (msec < 0) ? msec : qMax(msec, QUICK_CLOCK_MIN_UPDATE_INTERVAL);
 }
 
 qreal
@@ -84,22 +133,7 @@ ClockRenderer::nodeAngle(
     NodeType aType,
     const QTime& aTime)
 {
-    if (aType == NodeSec) {
-        return 6 * (aTime.second() + aTime.msec()/1000.0);
-    } else {
-        QTime t;
-        if (aTime.second() == 0) {
-            QTime t1 = aTime.addSecs(-1);
-            t = QTime(t1.hour(), t1.minute(), 60*t1.msec()/1000);
-        } else {
-            t = QTime(aTime.hour(), aTime.minute(), 0);
-        }
-        if (aType == NodeHour) {
-            return 30*(t.hour() + (t.minute() + t.second()/60.0)/60);
-        } else {
-            return 6*(t.minute() + (t.second() + t.msec()/1000.0)/60);
-        }
-    }
+    return motionProfile(aType).angle(aTime);
 }
 
 QMatrix4x4
@@ -114,6 +148,25 @@ ClockRenderer::nodeMatrix(
         rotate(nodeAngle(aType, aTime) - 90).translate(-dx, -dy));
 }
 
+QSharedPointer<const ClockDialTicks>
+ClockRenderer::dialTicks(
+    const QSize& aSize)
+{
+    return iDialTicksCache.get(aSize, this);
+}
+
+QRect
+ClockRenderer::secHandBounds(
+    const QSize& aSize,
+    qreal aAngle)
+{
+    const QRectF rect(QTransform::fromTranslate(aSize.width()/2.0,
+        aSize.height()/2.0).rotate(aAngle - 90).
+        mapRect(secHandRect(aSize)));
+    // Leave room for antialiasing
+    return rect.toAlignedRect().adjusted(-1, -1, 1, 1);
+}
+
 QSGGeometry*
 ClockRenderer::rectGeometry(
     const QRectF& aRect)
@@ -128,25 +181,84 @@ ClockRenderer::rectGeometry(
     return g;
 }
 
+// Width of the antialiased edge for the nodes rendered in this window.
+// Multisampled windows don't need it. The number of samples is taken
+// from the context, i.e. what was actually granted rather than what
+// was requested. The context only exists on the render thread, which
+// is where the nodes get created.
+qreal
+ClockRenderer::featherWidth(
+    QQuickWindow* aWindow)
+{
+    QOpenGLContext* context = aWindow ? aWindow->openglContext() : NULL;
+    return (context && context->format().samples() > 1) ? 0 : 1;
+}
+
+// Number of segments approximating the circle of the given radius.
+// The sagitta of a segment spanning 2*pi/n radians is r*(1-cos(pi/n)),
+// keep it under CIRCLE_TOLERANCE. Multiples of 4 keep the polygon
+// symmetrical relative to both axes.
+int
+ClockRenderer::circleSegments(
+    qreal aRadius)
+{
+    if (aRadius > CIRCLE_TOLERANCE) {
+        const int n = (int)ceil(M_PI / acos(1 - CIRCLE_TOLERANCE / aRadius));
+        return qBound(CIRCLE_MIN_SEGMENTS, (n + 3) & ~3, CIRCLE_MAX_SEGMENTS);
+    } else {
+        return CIRCLE_MIN_SEGMENTS;
+    }
+}
+
+// Unit circle points for the given number of segments (plus the first
+// point repeated at the end), computed once and shared by all clocks.
+// The tables are never deallocated.
+const QSGGeometry::Point2D*
+ClockRenderer::unitCircle(
+    int aSegments)
+{
+    static QMutex mutex;
+    static QSGGeometry::Point2D* tables[CIRCLE_MAX_SEGMENTS/4 + 1];
+
+    // circleSegments() only returns multiples of 4
+    Q_ASSERT(!(aSegments % 4) && aSegments <= CIRCLE_MAX_SEGMENTS);
+    QMutexLocker locker(&mutex);
+    QSGGeometry::Point2D* table = tables[aSegments/4];
+    if (!table) {
+        table = new QSGGeometry::Point2D[aSegments + 1];
+        for (int i = 0; i < aSegments; i++) {
+            const double theta = i*2*M_PI/aSegments;
+            table[i].x = cos(theta);
+            table[i].y = sin(theta);
+        }
+        table[aSegments] = table[0];
+        tables[aSegments/4] = table;
+    }
+    return table;
+}
+
+// The loops below are kept trivial so that the compiler can vectorize
+// them, there's no trigonometry left in there.
 QSGGeometry*
 ClockRenderer::circleGeometry(
     const QPointF& aCenter,
     qreal aRadius)
 {
-    const int n = 8*aRadius;
+    const int n = circleSegments(aRadius);
+    const QSGGeometry::Point2D* u = unitCircle(n);
     const float x0 = aCenter.x();
     const float y0 = aCenter.y();
+    const float r = aRadius;
     QSGGeometry* g = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), n+2);
     QSGGeometry::Point2D* v = g->vertexDataAsPoint2D();
     g->setDrawingMode(GL_TRIANGLE_FAN);
     v[0].x = x0;
     v[0].y = y0;
-    for (int i=0; i<n; i++) {
-        const float theta = i*2*M_PI/n;
-        v[i+1].x = x0 + aRadius*cos(theta);
-        v[i+1].y = y0 + aRadius*sin(theta);
+    v++;
+    for (int i=0; i<=n; i++) {
+        v[i].x = x0 + r*u[i].x;
+        v[i].y = y0 + r*u[i].y;
     }
-    v[n+1] = v[1];
     return g;
 }
 
@@ -156,22 +268,21 @@ ClockRenderer::ringGeometry(
     qreal aRadius,
     qreal aThickness)
 {
-    const int n = 8*aRadius;
+    const int n = circleSegments(aRadius);
+    const QSGGeometry::Point2D* u = unitCircle(n);
     const float x0 = aCenter.x();
     const float y0 = aCenter.y();
-    const float innerRadius = aRadius - qMin(aRadius, aThickness);
+    const float r1 = aRadius - qMin(aRadius, aThickness);
+    const float r2 = aRadius;
     QSGGeometry* g = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 2*(n+1));
     QSGGeometry::Point2D* v = g->vertexDataAsPoint2D();
     g->setDrawingMode(GL_TRIANGLE_STRIP);
-    for (int i=0; i<n; i++) {
-        const float theta = i*2*M_PI/n;
-        v[2*i].x = x0 + innerRadius*cos(theta);
-        v[2*i].y = y0 + innerRadius*sin(theta);
-        v[2*i+1].x = x0 + aRadius*cos(theta);
-        v[2*i+1].y = y0 + aRadius*sin(theta);
+    for (int i=0; i<=n; i++) {
+        v[2*i].x = x0 + r1*u[i].x;
+        v[2*i].y = y0 + r1*u[i].y;
+        v[2*i+1].x = x0 + r2*u[i].x;
+        v[2*i+1].y = y0 + r2*u[i].y;
     }
-    v[2*n] = v[0];
-    v[2*n+1] = v[1];
     return g;
 }
 
@@ -198,9 +309,20 @@ ClockRenderer::centerDiskNode(
     int aCenterRadius,
     const QColor& aColor)
 {
-    QSGNode* disk = circleNode(aCenter, aRadius, aColor);
-    disk->appendChildNode(centerNode(aWindow, aCenter, aCenterRadius));
-    return disk;
+    const int r = qMax(aCenterRadius & ~1, 2);
+    const int r2 = qMax((aCenterRadius/2) & ~1, 1);
+    ClockGeometryBuilder disk(featherWidth(aWindow));
+    disk.addCircle(aCenter, aRadius, aColor);
+    if (r2 == 1) {
+        // The center is too small, it's a texture
+        QSGNode* node = disk.node();
+        node->appendChildNode(centerNode(aWindow, aCenter, aCenterRadius));
+        return node;
+    } else {
+        disk.addCircle(aCenter, r, Qt::white);
+        disk.addCircle(aCenter, r2, Qt::black);
+        return disk.node();
+    }
 }
 
 QSGNode*
@@ -35,8 +35,11 @@
 #define CLOCK_RENDERER_H
 
 #include "ClockTheme.h"
+#include "ClockGeometryCache.h"
+#include "ClockMotionProfile.h"
 
 #include <QSize>
+#include <QList>
 #include <QColor>
 #include <QImage>
 #include <QPainter>
@@ -45,10 +48,9 @@
 #include <QMatrix4x4>
 #include <QSGGeometryNode>
 
-#define QUICK_CLOCK_MIN_UPDATE_INTERVAL_DISPLAY_ON  (15)
-#define QUICK_CLOCK_MIN_UPDATE_INTERVAL_DISPLAY_OFF (200)
-#define QUICK_CLOCK_MIN_UPDATE_INTERVAL \
-        QUICK_CLOCK_MIN_UPDATE_INTERVAL_DISPLAY_ON
+class ClockDialTicks;
+
+#define QUICK_CLOCK_MIN_UPDATE_INTERVAL (15)
 
 class ClockRenderer
 {
@@ -58,25 +60,45 @@ public:
     enum NodeType {
         NodeHour,
         NodeMin,
-        NodeSec
+        NodeSec,
+        NodeDial
     };
 
     virtual ~ClockRenderer();
 
     // Hand angle (in degrees, starting from top of the clock)
     virtual qreal nodeAngle(NodeType, const QTime&);
+    const ClockMotionProfile& motionProfile(NodeType aType) const;
+
+    // Tick mark in the dial plate coordinates, i.e. with the origin in
+    // the center of the clock, before being rotated by aIndex*6 degrees
+    virtual QRectF tickMarkRect(const QSize& aSize, int aIndex) = 0;
+    QSharedPointer<const ClockDialTicks> dialTicks(const QSize& aSize);
 
     // Raster interface
     virtual void paintDialPlate(QPainter* aPainter, const QSize& aSize,
         ClockTheme* aTheme, bool aDrawBackground) = 0;
     virtual void paintHourMinHands(QPainter* aPainter, const QSize& aSize,
         const QTime& aTime, ClockTheme* aTheme) = 0;
-    virtual void paintSecHand(QPainter* aPainter, const QSize& aSize,
-        const QTime& aTime, ClockTheme* aTheme) = 0;
+    virtual void paintSecHandAt(QPainter* aPainter, const QSize& aSize,
+        qreal aAngle, ClockTheme* aTheme) = 0;
+    void paintSecHand(QPainter* aPainter, const QSize& aSize,
+        const QTime& aTime, ClockTheme* aTheme);
+
+    // Area covered by the second hand (including the center disk) in
+    // the hand coordinates, i.e. with the origin in the center of the
+    // clock and the hand pointing to the right
+    virtual QRectF secHandRect(const QSize& aSize) = 0;
+
+    // The same area in the item coordinates, for partial updates
+    QRect secHandBounds(const QSize& aSize, qreal aAngle);
+    QRect secHandBounds(const QSize& aSize, const QTime& aTime);
 
     // Optimized interface
     virtual void initNode(QSGTransformNode* aTxNode, NodeType aType,
         QQuickWindow* aWindow, const QSizeF& aSize, ClockTheme* aTheme) = 0;
+    virtual void initDialPlate(QSGNode* aNode, QQuickWindow* aWindow,
+        const QSizeF& aSize, ClockTheme* aTheme, bool aDrawBackground) = 0;
     virtual int msecUntilNextUpdate(NodeType aType, const QTime& aTime);
     QMatrix4x4 nodeMatrix(NodeType aType, const QSize& aSize,
         const QTime& aTime);
@@ -84,6 +106,9 @@ public:
     const QString id() const { return iId; }
 
     // Utilities
+    static qreal featherWidth(QQuickWindow* aWindow);
+    static int circleSegments(qreal aRadius);
+    static const QSGGeometry::Point2D* unitCircle(int aSegments);
     static QSGGeometry* rectGeometry(const QRectF& aRect);
     static QSGGeometry* circleGeometry(const QPointF& aCenter, qreal aRadius);
     static QSGGeometry* ringGeometry(const QPointF& aCenter, qreal aRadius,
@@ -106,23 +131,38 @@ public:
     static const QString HELSINKI_METRO;
     static const QString DEUTSCHE_BAHN;
 
-    static ClockRenderer* newSwissRailroad();
-    static ClockRenderer* newHelsinkiMetro();
-    static ClockRenderer* newDeutscheBahn();
+    // Renderers are shared by all clocks and must not keep any state
+    // which depends on the clock size (see ClockGeometryCache)
+    static ClockRenderer* swissRailroad();
+    static ClockRenderer* helsinkiMetro();
+    static ClockRenderer* deutscheBahn();
+    static QList<ClockRenderer*> all();
+    static ClockRenderer* find(const QString& aId);
 
 protected:
-    ClockRenderer(QString aId) : iId(aId) {}
+    ClockRenderer(QString aId);
+    void setMotionProfile(NodeType aType, const ClockMotionProfile& aProfile);
 
 private:
     const QString iId;
+    ClockMotionProfile iMotionProfile[NodeDial + 1]; // The dial never moves
+    ClockGeometryCache<ClockDialTicks> iDialTicksCache;
 };
 
+inline const ClockMotionProfile& ClockRenderer::motionProfile(NodeType aType)
+    const { return iMotionProfile[aType]; }
 inline QSGNode* ClockRenderer::circleNode(const QPointF& aCenter,
     qreal aRadius, const QColor& aColor)
     { return geometryNode(circleGeometry(aCenter, aRadius), aColor); }
 inline QSGNode* ClockRenderer::ringNode(const QPointF& aCenter,
     qreal aRadius, qreal aThickness, const QColor& aColor)
     { return geometryNode(ringGeometry(aCenter, aRadius, aThickness), aColor); }
+inline void ClockRenderer::paintSecHand(QPainter* aPainter,
+    const QSize& aSize, const QTime& aTime, ClockTheme* aTheme)
+    { paintSecHandAt(aPainter, aSize, nodeAngle(NodeSec, aTime), aTheme); }
+inline QRect ClockRenderer::secHandBounds(const QSize& aSize,
+    const QTime& aTime)
+    { return secHandBounds(aSize, nodeAngle(NodeSec, aTime)); }
 inline QSGNode* ClockRenderer::rectNode(const QRectF& aRect, const QColor& aColor)
     { return geometryNode(rectGeometry(aRect), aColor); }
 
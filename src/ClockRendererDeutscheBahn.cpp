@@ -38,28 +38,42 @@
  */
 
 #include "ClockRenderer.h"
+#include "ClockDialTicks.h"
+#include "ClockGeometryBuilder.h"
+#include "ClockGeometryCache.h"
 #include "ClockDebug.h"
 
+#include <QPainterPath>
 #include <math.h>
 
 const QString ClockRenderer::DEUTSCHE_BAHN("DeutscheBahn");
 
 class DeutscheBahn : public ClockRenderer
 {
+    class SecHand;
+
 public:
+    QRectF tickMarkRect(const QSize& aSize, int aIndex) Q_DECL_OVERRIDE;
     void paintDialPlate(QPainter*, const QSize&, ClockTheme* aTheme,
         bool aDrawBackground) Q_DECL_OVERRIDE;
     void paintHourMinHands(QPainter* aPainter, const QSize& aSize,
         const QTime& aTime, ClockTheme* aTheme) Q_DECL_OVERRIDE;
-    void paintSecHand(QPainter* aPainter, const QSize& aSize,
-        const QTime& aTime, ClockTheme* aTheme) Q_DECL_OVERRIDE;
+    void paintSecHandAt(QPainter* aPainter, const QSize& aSize,
+        qreal aAngle, ClockTheme* aTheme) Q_DECL_OVERRIDE;
+    QRectF secHandRect(const QSize& aSize) Q_DECL_OVERRIDE;
     void initNode(QSGTransformNode* aTxNode, NodeType aType,
         QQuickWindow* aWindow, const QSizeF& aSize,
         ClockTheme* aTheme) Q_DECL_OVERRIDE;
+    void initDialPlate(QSGNode* aNode, QQuickWindow* aWindow,
+        const QSizeF& aSize, ClockTheme* aTheme,
+        bool aDrawBackground) Q_DECL_OVERRIDE;
 
-    void initHour(QSGTransformNode*, const QSizeF&, ClockTheme*);
-    void initMin(QSGTransformNode*, const QSizeF&, ClockTheme*);
-    void initSec(QSGTransformNode*, const QSizeF&, ClockTheme*);
+    void initHour(QSGTransformNode*, QQuickWindow*, const QSizeF&,
+        ClockTheme*);
+    void initMin(QSGTransformNode*, QQuickWindow*, const QSizeF&,
+        ClockTheme*);
+    void initSec(QSGTransformNode*, QQuickWindow*, const QSizeF&,
+        ClockTheme*);
     static void paintHand(QPainter* aPainter, const QRectF& aRect,
         qreal aAngle, const QBrush& aBrush, qreal aX = 0.0, qreal aY = 0.0);
 
@@ -67,12 +81,83 @@ public:
         iSecondHandColor(255,32,32) {}
 
     const QColor iSecondHandColor;
+    ClockGeometryCache<SecHand> iSecHandCache;
 };
 
+// Second hand outline for the particular clock size
+class DeutscheBahn::SecHand
+{
+public:
+    SecHand(const QSize& aSize, const DeutscheBahn* aRenderer);
+
+    QPainterPath iTail;
+    QPainterPath iTip;
+    qreal iRingX;
+    qreal iRingRadius;
+    qreal iRingWidth;
+    QRectF iBounds;
+};
+
+DeutscheBahn::SecHand::SecHand(
+    const QSize& aSize,
+    const DeutscheBahn*)
+{
+    const qreal d = qMin(aSize.width(), aSize.height());
+    const qreal x1 = d * 0.227;
+    const qreal x3 = d * 0.332;
+    const qreal x4 = d * 0.486;
+    const qreal y1 = qMax(d * qreal(0.011), qreal(2));
+    const qreal y2 = qMax(d * qreal(0.009), qreal(1));
+    const qreal y3 = qMax(d * qreal(0.008), qreal(1));
+    const qreal y4 = qMax(d * qreal(0.0065), qreal(1));
+
+    iRingX = d * 0.28;
+    iRingRadius = qMax(d * qreal(0.052), qreal(2));
+    iRingWidth = qMax(d * qreal(0.015), qreal(1));
+
+    iTail.moveTo(0, y1);
+    iTail.lineTo(x1, y2);
+    iTail.lineTo(x1, -y2);
+    iTail.lineTo(0, -y1);
+    iTail.closeSubpath();
+
+    iTip.moveTo(x3, y3);
+    iTip.lineTo(x4, y4);
+    iTip.lineTo(x4, -y4);
+    iTip.lineTo(x3, -y3);
+    iTip.closeSubpath();
+
+    // Tail, tip, the ring and the center disk (the widest of them)
+    const qreal r = iRingRadius + iRingWidth/2;
+    const qreal dy = qMax(qMax(y1, r), iRingRadius + 2);
+    iBounds = QRectF(-(iRingRadius + 2), -dy,
+        qMax(x4, iRingX + r) + iRingRadius + 2, 2*dy);
+}
+
 ClockRenderer*
-ClockRenderer::newDeutscheBahn()
+ClockRenderer::deutscheBahn()
 {
-    return new DeutscheBahn;
+    static DeutscheBahn instance;
+    return &instance;
+}
+
+QRectF
+DeutscheBahn::tickMarkRect(
+    const QSize& aSize,
+    int aIndex)
+{
+    const qreal d = qMin(aSize.width(), aSize.height());
+    const qreal x4 = d * 0.48;
+    if (aIndex % 5) {
+        const qreal y1 = qMax(d * qreal(0.008), qreal(1));
+        const qreal x3 = d * 0.445;
+        return QRectF(x3, -y1, (x4-x3), 2*y1);
+    } else {
+        // Longer marks at 3, 6, 9 and 12 o'clock
+        const qreal y = qMax(d * qreal(0.02), qreal(1));
+        const qreal x = d * ((aIndex % 15) ? 0.364 : 0.34);
+        return QRectF(x, -y, (x4-x), 2*y);
+    }
 }
 
 void
@@ -97,29 +182,9 @@ DeutscheBahn::paintDialPlate(
         aPainter->drawEllipse(center, d/2, d/2);
     }
 
-    const qreal y = qMax(d * qreal(0.02), qreal(1));
-    const qreal y1 = qMax(d * qreal(0.008), qreal(1));
-    const qreal x1 = d * 0.34;
-    const qreal x2 = d * 0.364;
-    const qreal x3 = d * 0.445;
-    const qreal x4 = d * 0.48;
-    QRectF minMarkRect(x3, -y1, (x4-x3), 2*y1);
-    QRectF hourMarkRect1(x2, -y, (x4-x2), 2*y);
-    QRectF hourMarkRect2(x1, -y, (x4-x1), 2*y);
-    QBrush markBrush(aTheme->iHourMinHandColor);
-
-    aPainter->setPen(aTheme->iHourMinHandColor);
-    for (int i=0; i<60; i++) {
-        if (i % 5) {
-            aPainter->fillRect(minMarkRect, markBrush);
-        } else if (i % 15) {
-            aPainter->fillRect(hourMarkRect1, markBrush);
-        } else {
-            aPainter->fillRect(hourMarkRect2, markBrush);
-        }
-        aPainter->rotate(6.0);
-    }
     aPainter->restore();
+
+    dialTicks(aSize)->paint(aPainter, aTheme->iHourMinHandColor);
 }
 
 void
@@ -173,58 +238,34 @@ DeutscheBahn::paintHourMinHands(
 }
 
 void
-DeutscheBahn::paintSecHand(
+DeutscheBahn::paintSecHandAt(
     QPainter* aPainter,
     const QSize& aSize,
-    const QTime& aTime,
+    qreal aAngle,
     ClockTheme* aTheme)
 {
     const qreal w = aSize.width();
     const qreal h = aSize.height();
-    const qreal d = qMin(w, h);
 
     QPointF center(0,0);
+    QSharedPointer<const SecHand> hand(iSecHandCache.get(aSize, this));
+    const qreal r = hand->iRingRadius;
 
     // Draw the second hand
-    const qreal x1 = d * 0.227;
-    const qreal x2 = d * 0.28;
-    const qreal x3 = d * 0.332;
-    const qreal x4 = d * 0.486;
-    const qreal y1 = qMax(d * qreal(0.011), qreal(2));
-    const qreal y2 = qMax(d * qreal(0.009), qreal(1));
-    const qreal y3 = qMax(d * qreal(0.008), qreal(1));
-    const qreal y4 = qMax(d * qreal(0.0065), qreal(1));
-    const qreal r = qMax(d * qreal(0.052), qreal(2));
-    const qreal dr = qMax(d * qreal(0.015), qreal(1));
-
-    QPainterPath p1;
-    p1.moveTo(0, y1);
-    p1.lineTo(x1, y2);
-    p1.lineTo(x1, -y2);
-    p1.lineTo(0, -y1);
-    p1.closeSubpath();
-
-    QPainterPath p2;
-    p2.moveTo(x3, y3);
-    p2.lineTo(x4, y4);
-    p2.lineTo(x4, -y4);
-    p2.lineTo(x3, -y3);
-    p2.closeSubpath();
-
     aPainter->save();
     aPainter->setPen(Qt::NoPen);
     aPainter->translate(w/2, h/2);
-    aPainter->rotate(nodeAngle(NodeSec, aTime) - 90);
+    aPainter->rotate(aAngle - 90);
 
     QBrush secBrush(iSecondHandColor);
-    QPen secPen(secBrush, dr);
+    QPen secPen(secBrush, hand->iRingWidth);
     aPainter->setPen(Qt::NoPen);
     aPainter->setBrush(secBrush);
-    aPainter->drawPath(p1);
-    aPainter->drawPath(p2);
+    aPainter->drawPath(hand->iTail);
+    aPainter->drawPath(hand->iTip);
     aPainter->setBrush(Qt::NoBrush);
     aPainter->setPen(secPen);
-    aPainter->drawEllipse(QPointF(x2,0), r, r);
+    aPainter->drawEllipse(QPointF(hand->iRingX,0), r, r);
 
     aPainter->setPen(Qt::NoPen);
     aPainter->setBrush(QBrush(aTheme->iHandShadowColor1));
@@ -238,9 +279,17 @@ DeutscheBahn::paintSecHand(
     aPainter->restore();
 }
 
+QRectF
+DeutscheBahn::secHandRect(
+    const QSize& aSize)
+{
+    return iSecHandCache.get(aSize, this)->iBounds;
+}
+
 void
 DeutscheBahn::initHour(
     QSGTransformNode* aTxNode,
+    QQuickWindow* aWindow,
     const QSizeF& aSize,
     ClockTheme* aTheme)
 {
@@ -249,13 +298,16 @@ DeutscheBahn::initHour(
     const qreal d = qMin(w, h);
     const qreal yh = round(qMax(d * qreal(0.024), qreal(2)));
     const qreal xh = round(d * 0.3);
-    QRectF rect(round(w/2), round(h/2)-yh, xh, 2*yh);
-    aTxNode->appendChildNode(rectNode(rect, aTheme->iHourMinHandColor));
+    ClockGeometryBuilder hand(featherWidth(aWindow));
+    hand.addRect(QRectF(round(w/2), round(h/2)-yh, xh, 2*yh),
+        aTheme->iHourMinHandColor);
+    aTxNode->appendChildNode(hand.node());
 }
 
 void
 DeutscheBahn::initMin(
     QSGTransformNode* aTxNode,
+    QQuickWindow* aWindow,
     const QSizeF& aSize,
     ClockTheme* aTheme)
 {
@@ -266,17 +318,17 @@ DeutscheBahn::initMin(
     const qreal xm = round(d * 0.466);
     const qreal x1 = round(w/2);
     const qreal y1 = round(h/2)-ym;
-    aTxNode->appendChildNode(rectNode(QRectF(x1, y1-2, xm+2, 2*ym+4),
-        aTheme->iHandShadowColor2));
-    aTxNode->appendChildNode(rectNode(QRectF(x1, y1-1, xm+1, 2*ym+2),
-        aTheme->iHandShadowColor1));
-    aTxNode->appendChildNode(rectNode(QRectF(x1, y1, xm, 2*ym),
-        aTheme->iHourMinHandColor));
+    ClockGeometryBuilder hand(featherWidth(aWindow));
+    hand.addRect(QRectF(x1, y1-2, xm+2, 2*ym+4), aTheme->iHandShadowColor2);
+    hand.addRect(QRectF(x1, y1-1, xm+1, 2*ym+2), aTheme->iHandShadowColor1);
+    hand.addRect(QRectF(x1, y1, xm, 2*ym), aTheme->iHourMinHandColor);
+    aTxNode->appendChildNode(hand.node());
 }
 
 void
 DeutscheBahn::initSec(
     QSGTransformNode* aTxNode,
+    QQuickWindow* aWindow,
     const QSizeF& aSize,
     ClockTheme* aTheme)
 {
@@ -289,9 +341,9 @@ DeutscheBahn::initSec(
     HDEBUG("initializing" << qPrintable(id()) << "node");
 
     // Draw the second hand
-    const qreal x1 = d * 0.23;
+    const qreal x1 = d * 0.227;
     const qreal x2 = d * 0.28;
-    const qreal x3 = d * 0.33;
+    const qreal x3 = d * 0.332;
     const qreal x4 = d * 0.486;
     const qreal y1 = qMax(d * qreal(0.011), qreal(2));
     const qreal y2 = qMax(d * qreal(0.009), qreal(1));
@@ -300,30 +352,30 @@ DeutscheBahn::initSec(
     const qreal r1 = qMax(d * qreal(0.052), qreal(2));
     const qreal dr = qMax(d * qreal(0.015), qreal(1));
 
-    QSGGeometry* g = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(),4);
-    QSGGeometry::Point2D* v = g->vertexDataAsPoint2D();
-    g->setDrawingMode(GL_TRIANGLE_FAN);
-    v[0].x = x0;     v[0].y = y0+y1;
-    v[1].x = x0+x1;  v[1].y = y0+y2;
-    v[2].x = v[1].x; v[2].y = y0-y2;
-    v[3].x = v[0].x; v[3].y = y0-y1;
-    aTxNode->appendChildNode(geometryNode(g, iSecondHandColor));
-
-    g = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(),4);
-    v = g->vertexDataAsPoint2D();
-    g->setDrawingMode(GL_TRIANGLE_FAN);
-    v[0].x = x0+x3;  v[0].y = y0+y3;
-    v[1].x = x0+x4;  v[1].y = y0+y4;
-    v[2].x = v[1].x; v[2].y = y0-y4;
-    v[3].x = v[0].x; v[3].y = y0-y3;
-    aTxNode->appendChildNode(geometryNode(g, iSecondHandColor));
-    aTxNode->appendChildNode(ringNode(QPointF(x0+x2,y0), r1+dr/2, dr, iSecondHandColor));
+    const qreal feather = featherWidth(aWindow);
+    QPolygonF tail, tip;
+    tail.reserve(4);
+    tail.append(QPointF(x0, y0+y1));
+    tail.append(QPointF(x0+x1, y0+y2));
+    tail.append(QPointF(x0+x1, y0-y2));
+    tail.append(QPointF(x0, y0-y1));
+    tip.reserve(4);
+    tip.append(QPointF(x0+x3, y0+y3));
+    tip.append(QPointF(x0+x4, y0+y4));
+    tip.append(QPointF(x0+x4, y0-y4));
+    tip.append(QPointF(x0+x3, y0-y3));
+    ClockGeometryBuilder hand(feather);
+    hand.addConvexPolygon(tail, iSecondHandColor);
+    hand.addConvexPolygon(tip, iSecondHandColor);
+    hand.addRing(QPointF(x0+x2,y0), r1+dr/2, dr, iSecondHandColor);
+    aTxNode->appendChildNode(hand.node());
 
     QPointF center(x0,y0);
-    QSGNode* rootNode = aTxNode->parent();
-    rootNode->appendChildNode(circleNode(center, r1+2, aTheme->iHandShadowColor2));
-    rootNode->appendChildNode(circleNode(center, r1+1, aTheme->iHandShadowColor1));
-    rootNode->appendChildNode(circleNode(center, r1, aTheme->iHourMinHandColor));
+    ClockGeometryBuilder disk(feather);
+    disk.addCircle(center, r1+2, aTheme->iHandShadowColor2);
+    disk.addCircle(center, r1+1, aTheme->iHandShadowColor1);
+    disk.addCircle(center, r1, aTheme->iHourMinHandColor);
+    aTxNode->parent()->appendChildNode(disk.node());
 }
 
 void
@@ -336,16 +388,38 @@ DeutscheBahn::initNode(
 {
     switch (aType) {
     case NodeHour:
-        initHour(aTxNode, aSize, aTheme);
+        initHour(aTxNode, aWindow, aSize, aTheme);
         break;
     case NodeMin:
-        initMin(aTxNode, aSize, aTheme);
+        initMin(aTxNode, aWindow, aSize, aTheme);
         break;
     case NodeSec:
-        initSec(aTxNode, aSize, aTheme);
+        initSec(aTxNode, aWindow, aSize, aTheme);
         break;
     default:
         HWARN("Unsupported node type" << aType);
         break;
     }
 }
+
+void
+DeutscheBahn::initDialPlate(
+    QSGNode* aNode,
+    QQuickWindow* aWindow,
+    const QSizeF& aSize,
+    ClockTheme* aTheme,
+    bool aDrawBackground)
+{
+    const qreal w = aSize.width();
+    const qreal h = aSize.height();
+    const qreal d = qMin(w, h);
+    const QPointF center(w/2, h/2);
+    ClockGeometryBuilder dial(featherWidth(aWindow));
+
+    if (aDrawBackground) {
+        dial.addCircle(center, d/2, aTheme->iBackgroundColor);
+    }
+
+    dialTicks(aSize.toSize())->addTo(&dial, aTheme->iHourMinHandColor);
+    aNode->appendChildNode(dial.node());
+}
@@ -38,6 +38,9 @@
  */
 
 #include "ClockRenderer.h"
+#include "ClockDialTicks.h"
+#include "ClockGeometryBuilder.h"
+#include "ClockGeometryCache.h"
 #include "ClockDebug.h"
 
 #include <QPainterPath>
@@ -47,25 +50,33 @@ const QString ClockRenderer::HELSINKI_METRO("HelsinkiMetro");
 
 class HelsinkiMetro : public ClockRenderer
 {
+    class SecHand;
+
 public:
     HelsinkiMetro();
-    ~HelsinkiMetro() Q_DECL_OVERRIDE;
 
+    QRectF tickMarkRect(const QSize& aSize, int aIndex) Q_DECL_OVERRIDE;
     void paintDialPlate(QPainter* aPainter, const QSize& aSize,
         ClockTheme* aTheme, bool aDrawBackground) Q_DECL_OVERRIDE;
     void paintHourMinHands(QPainter* aPainter, const QSize& aSize,
         const QTime& aTime, ClockTheme* aTheme) Q_DECL_OVERRIDE;
-    void paintSecHand(QPainter* aPainter, const QSize& aSize,
-        const QTime& aTime, ClockTheme* aTheme) Q_DECL_OVERRIDE;
+    void paintSecHandAt(QPainter* aPainter, const QSize& aSize,
+        qreal aAngle, ClockTheme* aTheme) Q_DECL_OVERRIDE;
+    QRectF secHandRect(const QSize& aSize) Q_DECL_OVERRIDE;
     void initNode(QSGTransformNode* aTxNode, NodeType aType,
         QQuickWindow* aWindow, const QSizeF& aSize,
         ClockTheme* aTheme) Q_DECL_OVERRIDE;
-
-    void initHour(QSGTransformNode*, const QSizeF&, ClockTheme*);
-    void initMin(QSGTransformNode*, const QSizeF&, ClockTheme*);
+    void initDialPlate(QSGNode* aNode, QQuickWindow* aWindow,
+        const QSizeF& aSize, ClockTheme* aTheme,
+        bool aDrawBackground) Q_DECL_OVERRIDE;
+
+    void initHour(QSGTransformNode*, QQuickWindow*, const QSizeF&,
+        ClockTheme*);
+    void initMin(QSGTransformNode*, QQuickWindow*, const QSizeF&,
+        ClockTheme*);
     void initSec(QSGTransformNode*, QQuickWindow*, const QSizeF&);
 
-    static QSGNode* handNode(const QRectF&, const QColor&);
+    static QPolygonF handPolygon(const QRectF&);
     static void paintHand(QPainter* aPainter, const QRectF& aRect,
         qreal aAngle, const QBrush& aBrush, qreal aX = 0.0, qreal aY = 0.0);
 
@@ -73,16 +84,69 @@ public:
     const QBrush iSecondHandBrush;
     const QBrush iBlack;
     const QBrush iWhite;
+    ClockGeometryCache<SecHand> iSecHandCache;
+};
+
+// Second hand polygon and the center disk for the particular clock size
+class HelsinkiMetro::SecHand
+{
+public:
+    SecHand(const QSize& aSize, const HelsinkiMetro* aRenderer);
+
     QPolygonF iPolygon;
-    QSizeF iSize;
-    QQuickWindow* iWindow;
-    QPixmap* iCenterDiskPixmap;
+    QImage iCenterDisk;
+    QRectF iBounds;
+    int iRadius;
 };
 
+HelsinkiMetro::SecHand::SecHand(
+    const QSize& aSize,
+    const HelsinkiMetro* aRenderer)
+{
+    const qreal d = qMin(aSize.width(), aSize.height());
+    const qreal y = qMax(qreal(1), qreal(d / 195));
+    const qreal x1 = -(d / 6.97);
+    const qreal x2 = d / 2;
+    const int r = qMax((int)(d / 23), 3);
+
+    HDEBUG("new path" << aSize.width() << "x" << aSize.height());
+    QPointF origin(x1, 0);
+    iPolygon.append(origin);
+    iPolygon.append(QPointF(x1+y, -y));
+    iPolygon.append(QPointF(x2-y, -y));
+    iPolygon.append(QPointF(x2, 0));
+    iPolygon.append(QPointF(x2-y, y));
+    iPolygon.append(QPointF(x1+y, y));
+    iPolygon.append(origin);
+
+    QPointF center(0,0);
+    iRadius = r;
+    iCenterDisk = QImage(2*(r+1), 2*(r+1), QImage::Format_ARGB32_Premultiplied);
+    iCenterDisk.fill(Qt::transparent);
+    QPainter diskPainter(&iCenterDisk);
+    diskPainter.setPen(Qt::NoPen);
+    diskPainter.setBrush(aRenderer->iSecondHandColor);
+    diskPainter.setRenderHint(QPainter::Antialiasing);
+    diskPainter.setRenderHint(QPainter::HighQualityAntialiasing);
+    diskPainter.translate(r+1, r+1);
+    diskPainter.drawEllipse(center, r, r);
+
+    const int rw = qMax((int)d/200, 2);
+    const int rb = qMax((rw/2) & ~1, 1);
+    diskPainter.setBrush(QBrush(Qt::white));
+    diskPainter.drawEllipse(center, rw, rw);
+    diskPainter.setBrush(QBrush(Qt::black));
+    diskPainter.drawEllipse(center, rb, rb);
+
+    iBounds = iPolygon.boundingRect().united(QRectF(-(r+1), -(r+1),
+        iCenterDisk.width(), iCenterDisk.height()));
+}
+
 ClockRenderer*
-ClockRenderer::newHelsinkiMetro()
+ClockRenderer::helsinkiMetro()
 {
-    return new HelsinkiMetro;
+    static HelsinkiMetro instance;
+    return &instance;
 }
 
 HelsinkiMetro::HelsinkiMetro() :
@@ -90,15 +154,26 @@ HelsinkiMetro::HelsinkiMetro() :
     iSecondHandColor(255, 0, 0),
     iSecondHandBrush(iSecondHandColor, Qt::SolidPattern),
     iBlack(Qt::black),
-    iWhite(Qt::white),
-    iWindow(NULL),
-    iCenterDiskPixmap(NULL)
+    iWhite(Qt::white)
 {
 }
 
-HelsinkiMetro::~HelsinkiMetro()
+QRectF
+HelsinkiMetro::tickMarkRect(
+    const QSize& aSize,
+    int aIndex)
 {
-    if (iCenterDiskPixmap) delete iCenterDiskPixmap;
+    const qreal d = qMin(aSize.width(), aSize.height());
+    const qreal x3 = d / 2.1;
+    if (aIndex % 5) {
+        const qreal y1 = qMax(qreal(1), qreal(d / 195));
+        const qreal x2 = d / 2.25;
+        return QRectF(x2, -y1, (x3-x2), 2*y1);
+    } else {
+        const qreal y = d / 84;
+        const qreal x1 = d / 2.71;
+        return QRectF(x1, -y, (x3-x1), 2*y);
+    }
 }
 
 void
@@ -130,25 +205,9 @@ HelsinkiMetro::paintDialPlate(
         aPainter->drawEllipse(center, r3, r3);
     }
 
-    const qreal y = d / 84;
-    const qreal y1 = qMax(qreal(1), qreal(d / 195));
-    const qreal x1 = d / 2.71;
-    const qreal x2 = d / 2.25;
-    const qreal x3 = d / 2.1;
-    QRectF hourMarkRect(x1, -y, (x3-x1), 2*y);
-    QRectF minMarkRect(x2, -y1, (x3-x2), 2*y1);
-    QBrush markBrush(aTheme->iHourMinHandColor);
-
-    aPainter->setPen(aTheme->iHourMinHandColor);
-    for (int i=0; i<60; i++) {
-        if (i % 5) {
-            aPainter->fillRect(minMarkRect, markBrush);
-        } else {
-            aPainter->fillRect(hourMarkRect, markBrush);
-        }
-        aPainter->rotate(6.0);
-    }
     aPainter->restore();
+
+    dialTicks(aSize)->paint(aPainter, aTheme->iHourMinHandColor);
 }
 
 void
@@ -217,94 +276,55 @@ HelsinkiMetro::paintHourMinHands(
 }
 
 void
-HelsinkiMetro::paintSecHand(
+HelsinkiMetro::paintSecHandAt(
     QPainter* aPainter,
     const QSize& aSize,
-    const QTime& aTime,
+    qreal aAngle,
     ClockTheme* aTheme)
 {
     const qreal w = aSize.width();
     const qreal h = aSize.height();
-    const qreal d = qMin(w, h);
-    const int r = qMax((int)(d / 23), 3);
-
-    if (iSize != aSize) {
-        iSize = aSize;
-        iPolygon.clear();
-    }
-
-    if (iPolygon.isEmpty()) {
-        const qreal y = qMax(qreal(1), qreal(d / 195));
-        const qreal x1 = -(d / 6.97);
-        const qreal x2 = d / 2;
-
-        QTRACE("- new path");
-        iSize = aSize;
-        QPointF origin(x1, 0);
-        iPolygon.clear();
-        iPolygon.append(origin);
-        iPolygon.append(QPointF(x1+y, -y));
-        iPolygon.append(QPointF(x2-y, -y));
-        iPolygon.append(QPointF(x2, 0));
-        iPolygon.append(QPointF(x2-y, y));
-        iPolygon.append(QPointF(x1+y, y));
-        iPolygon.append(origin);
-    }
-
-    if (!iCenterDiskPixmap) {
-        QPointF center(0,0);
-        if (iCenterDiskPixmap) delete iCenterDiskPixmap;
-        iCenterDiskPixmap = new QPixmap(2*(r+1), 2*(r+1));
-        QPainter diskPainter(iCenterDiskPixmap);
-        diskPainter.setPen(Qt::NoPen);
-        diskPainter.setBrush(iSecondHandColor);
-        diskPainter.setRenderHint(QPainter::Antialiasing);
-        diskPainter.setRenderHint(QPainter::HighQualityAntialiasing);
-        diskPainter.setCompositionMode(QPainter::CompositionMode_Source);
-        diskPainter.fillRect(QRectF(0, 0, 2*(r+1), 2*(r+1)), Qt::transparent);
-        diskPainter.translate(r+1, r+1);
-        diskPainter.drawEllipse(center, r, r);
-
-        const int rw = qMax((int)d/200, 2);
-        const int rb = qMax((rw/2) & ~1, 1);
-        diskPainter.setBrush(QBrush(Qt::white));
-        diskPainter.drawEllipse(center, rw, rw);
-        diskPainter.setBrush(QBrush(Qt::black));
-        diskPainter.drawEllipse(center, rb, rb);
-    }
+    QSharedPointer<const SecHand> hand(iSecHandCache.get(aSize, this));
+    const int r = hand->iRadius;
 
     aPainter->save();
     aPainter->setPen(Qt::NoPen);
     aPainter->setBrush(iSecondHandBrush);
     aPainter->translate(w/2, h/2);
     aPainter->save();
-    aPainter->rotate(nodeAngle(NodeSec, aTime) - 90);
-    aPainter->drawPolygon(iPolygon);
+    aPainter->rotate(aAngle - 90);
+    aPainter->drawPolygon(hand->iPolygon);
     aPainter->restore();
-    aPainter->drawPixmap(-(r+1), -(r+1), *iCenterDiskPixmap);
+    aPainter->drawImage(-(r+1), -(r+1), hand->iCenterDisk);
     aPainter->restore();
 }
 
-QSGNode*
-HelsinkiMetro::handNode(
-    const QRectF& aRect,
-    const QColor& aColor)
+QRectF
+HelsinkiMetro::secHandRect(
+    const QSize& aSize)
+{
+    return iSecHandCache.get(aSize, this)->iBounds;
+}
+
+QPolygonF
+HelsinkiMetro::handPolygon(
+    const QRectF& aRect)
 {
     const qreal x = aRect.right() - aRect.height() / 3.0;
-    QSGGeometry* g = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 5);
-    QSGGeometry::Point2D* v = g->vertexDataAsPoint2D();
-    g->setDrawingMode(GL_TRIANGLE_FAN);
-    v[0].x = aRect.right(); v[0].y = aRect.top() + aRect.height()/2;
-    v[1].x = x;             v[1].y = aRect.top();
-    v[2].x = aRect.left();  v[2].y = v[1].y;
-    v[3].x = v[2].x;        v[3].y = aRect.bottom();
-    v[4].x = x;             v[4].y = v[3].y;
-    return geometryNode(g, aColor);
+    QPolygonF polygon;
+    polygon.reserve(5);
+    polygon.append(QPointF(aRect.right(), aRect.top() + aRect.height()/2));
+    polygon.append(QPointF(x, aRect.top()));
+    polygon.append(aRect.topLeft());
+    polygon.append(aRect.bottomLeft());
+    polygon.append(QPointF(x, aRect.bottom()));
+    return polygon;
 }
 
 void
 HelsinkiMetro::initHour(
     QSGTransformNode* aTxNode,
+    QQuickWindow* aWindow,
     const QSizeF& aSize,
     ClockTheme* aTheme)
 {
@@ -314,13 +334,16 @@ HelsinkiMetro::initHour(
     const qreal yh = d / 31;
     const qreal xh1 = -(d / 8.6);
     const qreal xh2 = d / 3.4;
-    QRectF hourHandRect(round(h/2)+xh1, round(h/2)-yh, (xh2-xh1), 2*yh);
-    aTxNode->appendChildNode(handNode(hourHandRect, aTheme->iHourMinHandColor));
+    QRectF hourHandRect(round(w/2)+xh1, round(h/2)-yh, (xh2-xh1), 2*yh);
+    ClockGeometryBuilder hand(featherWidth(aWindow));
+    hand.addConvexPolygon(handPolygon(hourHandRect), aTheme->iHourMinHandColor);
+    aTxNode->appendChildNode(hand.node());
 }
 
 void
 HelsinkiMetro::initMin(
     QSGTransformNode* aTxNode,
+    QQuickWindow* aWindow,
     const QSizeF& aSize,
     ClockTheme* aTheme)
 {
@@ -330,18 +353,20 @@ HelsinkiMetro::initMin(
     const qreal x = d / 2 - qMax(qreal(1), qreal(d / 98));
     const qreal y1 = d / 50;
     const qreal x1 = -(d / 8.6);
-    const qreal x2 = qMin(qreal(d / 2.03), x - 3);
+    const qreal x2 = qMin(qreal(d / 2.03), x - 2);
     const qreal dx = (x2-x1);
     const qreal dy = 2*y1;
     const qreal x0 = round(w/2)+x1;
     const qreal y0 = round(h/2)-y1;
 
-    aTxNode->appendChildNode(handNode(QRectF(x0-2, y0-2, dx+4, dy+4),
-        aTheme->iHandShadowColor2));
-    aTxNode->appendChildNode(handNode(QRectF(x0-1, y0-1, dx+2, dy+2),
-        aTheme->iHandShadowColor1));
-    aTxNode->appendChildNode(handNode(QRectF(x0, y0, dx, dy),
-        aTheme->iHourMinHandColor));
+    ClockGeometryBuilder hand(featherWidth(aWindow));
+    hand.addConvexPolygon(handPolygon(QRectF(x0-2, y0-2, dx+4, dy+4)),
+        aTheme->iHandShadowColor2);
+    hand.addConvexPolygon(handPolygon(QRectF(x0-1, y0-1, dx+2, dy+2)),
+        aTheme->iHandShadowColor1);
+    hand.addConvexPolygon(handPolygon(QRectF(x0, y0, dx, dy)),
+        aTheme->iHourMinHandColor);
+    aTxNode->appendChildNode(hand.node());
 }
 
 void
@@ -362,16 +387,17 @@ HelsinkiMetro::initSec(
     const qreal x2 = x0 + d/2;
 
     HDEBUG("initializing" << qPrintable(id()) << "node");
-    QSGGeometry* g = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(),6);
-    QSGGeometry::Point2D* v = g->vertexDataAsPoint2D();
-    g->setDrawingMode(GL_TRIANGLE_FAN);
-    v[0].x = x1;   v[0].y = y0;
-    v[1].x = x1+y; v[1].y = y0-y;
-    v[2].x = x2-y; v[2].y = y0-y;
-    v[3].x = x2;   v[3].y = y0;
-    v[4].x = x2-y; v[4].y = y0+y;
-    v[5].x = x1+y; v[5].y = y0+y;
-    aTxNode->appendChildNode(geometryNode(g, iSecondHandColor));
+    QPolygonF polygon;
+    polygon.reserve(6);
+    polygon.append(QPointF(x1, y0));
+    polygon.append(QPointF(x1+y, y0-y));
+    polygon.append(QPointF(x2-y, y0-y));
+    polygon.append(QPointF(x2, y0));
+    polygon.append(QPointF(x2-y, y0+y));
+    polygon.append(QPointF(x1+y, y0+y));
+    ClockGeometryBuilder hand(featherWidth(aWindow));
+    hand.addConvexPolygon(polygon, iSecondHandColor);
+    aTxNode->appendChildNode(hand.node());
     aTxNode->parent()->appendChildNode(centerDiskNode(aWindow,
         QPointF(x0,y0), r, rc, iSecondHandColor));
 }
@@ -386,10 +412,10 @@ HelsinkiMetro::initNode(
 {
     switch (aType) {
     case NodeHour:
-        initHour(aTxNode, aSize, aTheme);
+        initHour(aTxNode, aWindow, aSize, aTheme);
         break;
     case NodeMin:
-        initMin(aTxNode, aSize, aTheme);
+        initMin(aTxNode, aWindow, aSize, aTheme);
         break;
     case NodeSec:
         initSec(aTxNode, aWindow, aSize);
@@ -399,3 +425,30 @@ HelsinkiMetro::initNode(
         break;
     }
 }
+
+void
+HelsinkiMetro::initDialPlate(
+    QSGNode* aNode,
+    QQuickWindow* aWindow,
+    const QSizeF& aSize,
+    ClockTheme* aTheme,
+    bool aDrawBackground)
+{
+    const qreal w = aSize.width();
+    const qreal h = aSize.height();
+    const qreal d = qMin(w, h);
+    const QPointF center(w/2, h/2);
+    ClockGeometryBuilder dial(featherWidth(aWindow));
+    const qreal r1 = d / 2;
+    const qreal r2 = r1 - qMax(qreal(1), qreal(d / 98));
+    const qreal r3 = d / 16.25;
+
+    if (aDrawBackground) {
+        dial.addCircle(center, r1, aTheme->iBackgroundColor2);
+        dial.addCircle(center, r2, aTheme->iBackgroundColor);
+        dial.addCircle(center, r3, aTheme->iBackgroundColor1);
+    }
+
+    dialTicks(aSize.toSize())->addTo(&dial, aTheme->iHourMinHandColor);
+    aNode->appendChildNode(dial.node());
+}
@@ -38,10 +38,10 @@
  */
 
 #include "ClockRenderer.h"
+#include "ClockDialTicks.h"
+#include "ClockGeometryBuilder.h"
 #include "ClockDebug.h"
 
-#include <qmath.h>
-
 const QString ClockRenderer::SWISS_RAILROAD("SwissRailroad");
 
 class SwissRailroad : public ClockRenderer
@@ -52,20 +52,25 @@ public:
 
     SwissRailroad();
 
-    qreal nodeAngle(NodeType aType, const QTime& aTime) Q_DECL_OVERRIDE;
+    QRectF tickMarkRect(const QSize& aSize, int aIndex) Q_DECL_OVERRIDE;
     void paintDialPlate(QPainter* aPainter, const QSize& aSize,
         ClockTheme* aTheme, bool aDrawBackground) Q_DECL_OVERRIDE;
     void paintHourMinHands(QPainter* aPainter, const QSize& aSize,
         const QTime& aTime, ClockTheme* aTheme) Q_DECL_OVERRIDE;
-    void paintSecHand(QPainter* aPainter, const QSize& aSize,
-        const QTime& aTime, ClockTheme* aTheme) Q_DECL_OVERRIDE;
+    void paintSecHandAt(QPainter* aPainter, const QSize& aSize,
+        qreal aAngle, ClockTheme* aTheme) Q_DECL_OVERRIDE;
+    QRectF secHandRect(const QSize& aSize) Q_DECL_OVERRIDE;
     void initNode(QSGTransformNode* aTxNode, NodeType aType,
         QQuickWindow* aWindow, const QSizeF& aSize,
         ClockTheme* aTheme) Q_DECL_OVERRIDE;
-    int msecUntilNextUpdate(NodeType aType, const QTime& aTime) Q_DECL_OVERRIDE;
-
-    void initHour(QSGTransformNode*, const QSizeF&, ClockTheme*);
-    void initMin(QSGTransformNode*, const QSizeF&, ClockTheme*);
+    void initDialPlate(QSGNode* aNode, QQuickWindow* aWindow,
+        const QSizeF& aSize, ClockTheme* aTheme,
+        bool aDrawBackground) Q_DECL_OVERRIDE;
+
+    void initHour(QSGTransformNode*, QQuickWindow*, const QSizeF&,
+        ClockTheme*);
+    void initMin(QSGTransformNode*, QQuickWindow*, const QSizeF&,
+        ClockTheme*);
     void initSec(QSGTransformNode*, QQuickWindow*, const QSizeF&);
     static void paintHand(QPainter* aPainter, const QRectF& aRect,
         qreal aAngle, const QBrush& aBrush, qreal aX = 0.0, qreal aY = 0.0);
@@ -77,9 +82,10 @@ public:
 };
 
 ClockRenderer*
-ClockRenderer::newSwissRailroad()
+ClockRenderer::swissRailroad()
 {
-    return new SwissRailroad;
+    static SwissRailroad instance;
+    return &instance;
 }
 
 SwissRailroad::SwissRailroad() :
@@ -89,42 +95,29 @@ SwissRailroad::SwissRailroad() :
     iBlack(Qt::black),
     iWhite(Qt::white)
 {
+    // The second hand takes about 58.5 seconds to circle the face, then
+    // pauses briefly at the top of the clock. The minute hand overshoots
+    // a bit and settles when it moves.
+    setMotionProfile(NodeSec, ClockMotionProfile::stopToGo(60000,
+        SECOND_HAND_FULL_CIRCLE_MS, 360));
+    setMotionProfile(NodeMin, ClockMotionProfile::bounce(60000, 1000, 6));
 }
 
-int
-SwissRailroad::msecUntilNextUpdate(
-    NodeType aType,
-    const QTime& aTime)
-{
-    if (aType == NodeSec) {
-        const int msec = aTime.second() * 1000 + aTime.msec();
-        return (msec > SECOND_HAND_FULL_CIRCLE_MS) ?
-            qMax(60000 - msec, QUICK_CLOCK_MIN_UPDATE_INTERVAL) :
-            QUICK_CLOCK_MIN_UPDATE_INTERVAL;
-    } else {
-        return ClockRenderer::msecUntilNextUpdate(aType, aTime);
-    }
-}
-
-qreal
-SwissRailroad::nodeAngle(
-    NodeType aType,
-    const QTime& aTime)
+QRectF
+SwissRailroad::tickMarkRect(
+    const QSize& aSize,
+    int aIndex)
 {
-    if (aType == NodeSec) {
-        // It takes about 58.5 seconds to circle the face; then the hand
-        // pauses briefly at the top of the clock
-        const int msec = aTime.second() * 1000 + aTime.msec();
-        if (msec <= SECOND_HAND_FULL_CIRCLE_MS) {
-            return (360.0 * msec)/SECOND_HAND_FULL_CIRCLE_MS;
-        } else {
-            return 0.0;
-        }
-    } else if (aType == NodeMin && aTime.second() == 0) {
-        const qreal x = aTime.msec()/222.0;
-        return 6*(aTime.minute() - qExp(-1.5 * x) * qCos(2 * M_PI * x));
+    const qreal d = qMin(aSize.width(), aSize.height());
+    const qreal x1 = d * 10 / 27;
+    const qreal x2 = d * 10 / 21;
+    if (aIndex % 5) {
+        const qreal y1 = qMax(qreal(1), d / 158);
+        const qreal x = (x1+x2)/2;
+        return QRectF(x, -y1, (x2-x), 2*y1);
     } else {
-        return ClockRenderer::nodeAngle(aType, aTime);
+        const qreal y = d / 50;
+        return QRectF(x1, -y, (x2-x1), 2*y);
     }
 }
 
@@ -150,25 +143,9 @@ SwissRailroad::paintDialPlate(
         aPainter->drawEllipse(center, d/2, d/2);
     }
 
-    const qreal y = d / 50;
-    const qreal y1 = qMax(qreal(1), d / 158);
-    const qreal x1 = d * 10 / 27;
-    const qreal x2 = d * 10 / 21;
-    const qreal x = (x1+x2)/2;
-    QRectF hourMarkRect(x1, -y, (x2-x1), 2*y);
-    QRectF minMarkRect(x, -y1, (x2-x), 2*y1);
-    QBrush markBrush(aTheme->iHourMinHandColor);
-
-    aPainter->setPen(aTheme->iHourMinHandColor);
-    for (int i=0; i<60; i++) {
-        if (i % 5) {
-            aPainter->fillRect(minMarkRect, markBrush);
-        } else {
-            aPainter->fillRect(hourMarkRect, markBrush);
-        }
-        aPainter->rotate(6.0);
-    }
     aPainter->restore();
+
+    dialTicks(aSize)->paint(aPainter, aTheme->iHourMinHandColor);
 }
 
 void
@@ -225,10 +202,10 @@ SwissRailroad::paintHourMinHands(
 }
 
 void
-SwissRailroad::paintSecHand(
+SwissRailroad::paintSecHandAt(
     QPainter* aPainter,
     const QSize& aSize,
-    const QTime& aTime,
+    qreal aAngle,
     ClockTheme* aTheme)
 {
     const qreal w = aSize.width();
@@ -253,7 +230,7 @@ SwissRailroad::paintSecHand(
     aPainter->setPen(Qt::NoPen);
     aPainter->setBrush(iSecondHandBrush);
     aPainter->translate(w/2, h/2);
-    aPainter->rotate(nodeAngle(NodeSec, aTime) - 90);
+    aPainter->rotate(aAngle - 90);
     aPainter->fillRect(secHandRect, iSecondHandBrush);
     aPainter->drawEllipse(center, rs1, rs1);
     aPainter->drawEllipse(QPointF(xs2,0), rs2, rs2);
@@ -267,9 +244,26 @@ SwissRailroad::paintSecHand(
     aPainter->restore();
 }
 
+QRectF
+SwissRailroad::secHandRect(
+    const QSize& aSize)
+{
+    // Same geometry as in paintSecHand()
+    const qreal d = qMin(aSize.width(), aSize.height());
+    const qreal y = qMax(d / 50, qreal(5));
+    const qreal rs1 = y-1;
+    const qreal rs2 = d/26;
+    const qreal xs1 = -(d * 10 / 74) + d / 140;
+    const qreal xs2 = d * 10 / 27 - d / 50 - rs2;
+    const qreal x1 = qMin(xs1, -rs1);
+    const qreal dy = qMax(rs1, rs2);
+    return QRectF(x1, -dy, xs2 + rs2 - x1, 2*dy);
+}
+
 void
 SwissRailroad::initHour(
     QSGTransformNode* aTxNode,
+    QQuickWindow* aWindow,
     const QSizeF& aSize,
     ClockTheme* aTheme)
 {
@@ -279,13 +273,16 @@ SwissRailroad::initHour(
     const qreal y = qMax(qreal(round(d * 0.02)), qreal(1));
     const qreal x1 = -round(d * qreal(0.135));
     const qreal x2 = round(d * qreal(0.277));
-    QRectF rect(round(w/2)+x1, round(h/2)-y, (x2-x1), 2*y);
-    aTxNode->appendChildNode(rectNode(rect, aTheme->iHourMinHandColor));
+    ClockGeometryBuilder hand(featherWidth(aWindow));
+    hand.addRect(QRectF(round(w/2)+x1, round(h/2)-y, (x2-x1), 2*y),
+        aTheme->iHourMinHandColor);
+    aTxNode->appendChildNode(hand.node());
 }
 
 void
 SwissRailroad::initMin(
     QSGTransformNode* aTxNode,
+    QQuickWindow* aWindow,
     const QSizeF& aSize,
     ClockTheme* aTheme)
 {
@@ -300,12 +297,11 @@ SwissRailroad::initMin(
     const qreal x0 = round(w/2)+x1;
     const qreal y0 = round(h/2)-y1;
 
-    aTxNode->appendChildNode(rectNode(QRectF(x0-2, y0-2, dx+4, dy+4),
-        aTheme->iHandShadowColor2));
-    aTxNode->appendChildNode(rectNode(QRectF(x0-1, y0-1, dx+2, dy+2),
-        aTheme->iHandShadowColor1));
-    aTxNode->appendChildNode(rectNode(QRectF(x0, y0, dx, dy),
-        aTheme->iHourMinHandColor));
+    ClockGeometryBuilder hand(featherWidth(aWindow));
+    hand.addRect(QRectF(x0-2, y0-2, dx+4, dy+4), aTheme->iHandShadowColor2);
+    hand.addRect(QRectF(x0-1, y0-1, dx+2, dy+2), aTheme->iHandShadowColor1);
+    hand.addRect(QRectF(x0, y0, dx, dy), aTheme->iHourMinHandColor);
+    aTxNode->appendChildNode(hand.node());
 }
 void
 SwissRailroad::initSec(
@@ -331,15 +327,10 @@ SwissRailroad::initSec(
     const qreal xs2 = x1 - d / 50 - rs2;
 
     HDEBUG("initializing" << qPrintable(id()) << "node");
-    QSGGeometry* g = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 4);
-    QSGGeometry::Point2D* v = g->vertexDataAsPoint2D();
-    g->setDrawingMode(GL_TRIANGLE_FAN);
-    v[0].x = xs1;  v[0].y = y0 - ds/2.0;
-    v[1].x = xs1;  v[1].y = y0 + ds/2.0;
-    v[2].x = xs2;  v[2].y = v[1].y;
-    v[3].x = xs2;  v[3].y = v[0].y;
-    aTxNode->appendChildNode(geometryNode(g, iSecondHandColor));
-    aTxNode->appendChildNode(circleNode(QPointF(xs2, y0), rs2, iSecondHandColor));
+    ClockGeometryBuilder hand(featherWidth(aWindow));
+    hand.addRect(QRectF(xs1, y0 - ds/2.0, xs2 - xs1, ds), iSecondHandColor);
+    hand.addCircle(QPointF(xs2, y0), rs2, iSecondHandColor);
+    aTxNode->appendChildNode(hand.node());
     aTxNode->parent()->appendChildNode(centerDiskNode(aWindow,
         QPointF(x0,y0), rs, rc, iSecondHandColor));
 }
@@ -354,10 +345,10 @@ SwissRailroad::initNode(
 {
     switch (aType) {
     case NodeHour:
-        initHour(aTxNode, aSize, aTheme);
+        initHour(aTxNode, aWindow, aSize, aTheme);
         break;
     case NodeMin:
-        initMin(aTxNode, aSize, aTheme);
+        initMin(aTxNode, aWindow, aSize, aTheme);
         break;
     case NodeSec:
         initSec(aTxNode, aWindow, aSize);
@@ -367,3 +358,25 @@ SwissRailroad::initNode(
         break;
     }
 }
+
+void
+SwissRailroad::initDialPlate(
+    QSGNode* aNode,
+    QQuickWindow* aWindow,
+    const QSizeF& aSize,
+    ClockTheme* aTheme,
+    bool aDrawBackground)
+{
+    const qreal w = aSize.width();
+    const qreal h = aSize.height();
+    const qreal d = qMin(w, h);
+    const QPointF center(w/2, h/2);
+    ClockGeometryBuilder dial(featherWidth(aWindow));
+
+    if (aDrawBackground) {
+        dial.addCircle(center, d/2, aTheme->iBackgroundColor);
+    }
+
+    dialTicks(aSize.toSize())->addTo(&dial, aTheme->iHourMinHandColor);
+    aNode->appendChildNode(dial.node());
+}
@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "ClockScheduler.h"
+#include "ClockRenderer.h"
+#include "ClockDebug.h"
+
+#include <QSocketNotifier>
+
+#include <sys/timerfd.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef TFD_TIMER_CANCEL_ON_SET
+#  define TFD_TIMER_CANCEL_ON_SET (1 << 1)
+#endif
+
+// Deadlines this close to the one the timer has fired for are served by
+// the same wakeup. Being a few milliseconds early doesn't matter, every
+// client recalculates the hand positions from the current time anyway.
+#define COALESCE_MS (QUICK_CLOCK_MIN_UPDATE_INTERVAL/2)
+
+#define WAKEUP_WINDOW_MS (60000)
+
+#define MSECS_PER_MINUTE (60000)
+
+ClockScheduler::ClockScheduler() :
+    iTimerDeadline(0),
+    iTimeSource(ClockTimeSource::sharedInstance()),
+    iMinuteNotifier(NULL),
+    iMinuteTimerFd(timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK|TFD_CLOEXEC)),
+    iMinuteTimerArmed(false)
+{
+    iClock.start();
+    if (iMinuteTimerFd >= 0) {
+        iMinuteNotifier = new QSocketNotifier(iMinuteTimerFd,
+            QSocketNotifier::Read, this);
+        connect(iMinuteNotifier, SIGNAL(activated(int)),
+            SLOT(onMinuteTimer()));
+    } else {
+        HWARN("timerfd_create failed:" << strerror(errno));
+    }
+}
+
+ClockScheduler::~ClockScheduler()
+{
+    HDEBUG(wakeupsPerMinute() << "wakeups per minute");
+    if (iMinuteTimerFd >= 0) {
+        delete iMinuteNotifier;
+        close(iMinuteTimerFd);
+    }
+}
+
+QSharedPointer<ClockScheduler>
+ClockScheduler::sharedInstance()
+{
+    static QWeakPointer<ClockScheduler> sharedInstance;
+    QSharedPointer<ClockScheduler> instance = sharedInstance;
+    if (instance.isNull()) {
+        // QSharedPointer::create() can't access the private constructor
+        instance = QSharedPointer<ClockScheduler>(new ClockScheduler);
+        sharedInstance = instance;
+    }
+    return instance;
+}
+
+void
+ClockScheduler::schedule(
+    Client* aClient,
+    int aMsec)
+{
+    const qint64 deadline = iClock.elapsed() + qMax(aMsec, 0);
+    if (iMinuteClients.removeAll(aClient)) {
+        restartMinuteTimer();
+    }
+    for (int i = 0; i < iEntries.count(); i++) {
+        if (iEntries.at(i).first == aClient) {
+            iEntries[i].second = deadline;
+            restartTimer();
+            return;
+        }
+    }
+    iEntries.append(Entry(aClient, deadline));
+    restartTimer();
+}
+
+void
+ClockScheduler::schedule(
+    Client* aClient,
+    int aMsec,
+    const QTime& aTime)
+{
+    if (iMinuteTimerFd >= 0 && aMsec > COALESCE_MS &&
+        !((aTime.msecsSinceStartOfDay() + aMsec) % MSECS_PER_MINUTE)) {
+        cancel(aClient);
+        iMinuteClients.append(aClient);
+        restartMinuteTimer();
+    } else {
+        schedule(aClient, aMsec);
+    }
+}
+
+void
+ClockScheduler::cancel(
+    Client* aClient)
+{
+    iDue.removeAll(aClient);
+    if (iMinuteClients.removeAll(aClient)) {
+        restartMinuteTimer();
+    }
+    for (int i = 0; i < iEntries.count(); i++) {
+        if (iEntries.at(i).first == aClient) {
+            iEntries.removeAt(i);
+            restartTimer();
+            break;
+        }
+    }
+}
+
+bool
+ClockScheduler::isScheduled(
+    Client* aClient) const
+{
+    for (int i = 0; i < iEntries.count(); i++) {
+        if (iEntries.at(i).first == aClient) {
+            return true;
+        }
+    }
+    return iMinuteClients.contains(aClient);
+}
+
+void
+ClockScheduler::restartTimer()
+{
+    if (iEntries.isEmpty()) {
+        iTimer.stop();
+    } else {
+        qint64 deadline = iEntries.at(0).second;
+        for (int i = 1; i < iEntries.count(); i++) {
+            deadline = qMin(deadline, iEntries.at(i).second);
+        }
+        if (!iTimer.isActive() || iTimerDeadline != deadline) {
+            iTimerDeadline = deadline;
+            iTimer.start((int)qMax(deadline - iClock.elapsed(), qint64(0)),
+                Qt::PreciseTimer, this);
+        }
+    }
+}
+
+// Arms the timerfd for the top of the next minute, or disarms it
+void
+ClockScheduler::restartMinuteTimer()
+{
+    struct itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+    if (!iMinuteClients.isEmpty()) {
+        struct timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        spec.it_value.tv_sec = (now.tv_sec / 60 + 1) * 60;
+    } else if (!iMinuteTimerArmed) {
+        return;
+    }
+    // TFD_TIMER_CANCEL_ON_SET makes read() fail with ECANCELED when
+    // the system time is set
+    if (timerfd_settime(iMinuteTimerFd, TFD_TIMER_ABSTIME |
+        TFD_TIMER_CANCEL_ON_SET, &spec, NULL) < 0) {
+        HWARN("timerfd_settime failed:" << strerror(errno));
+    }
+    iMinuteTimerArmed = !iMinuteClients.isEmpty();
+}
+
+void
+ClockScheduler::onMinuteTimer()
+{
+    quint64 expirations;
+    if (read(iMinuteTimerFd, &expirations, sizeof(expirations)) < 0) {
+        if (errno == ECANCELED) {
+            // The clock has been set. Everyone gets woken up to check
+            // what time it is now.
+            HDEBUG("System time changed");
+            iTimeSource->refresh();
+        } else {
+            // Spurious wakeup (EAGAIN), the timer is still armed
+            return;
+        }
+    }
+    iMinuteTimerArmed = false;
+    iDue.append(iMinuteClients);
+    iMinuteClients.clear();
+    dispatch(iClock.elapsed());
+    restartMinuteTimer();
+}
+
+void
+ClockScheduler::dropOldWakeups(
+    qint64 aNow)
+{
+    while (!iWakeups.isEmpty() && iWakeups.head() <= aNow - WAKEUP_WINDOW_MS) {
+        iWakeups.dequeue();
+    }
+}
+
+// Old wakeups are dropped by dispatch(), this only skips those which
+// are still in the queue
+int
+ClockScheduler::wakeupsPerMinute() const
+{
+    const qint64 since = iClock.elapsed() - WAKEUP_WINDOW_MS;
+    int n = iWakeups.count();
+    for (int i = 0; i < iWakeups.count() && iWakeups.at(i) <= since; i++) {
+        n--;
+    }
+    return n;
+}
+
+// Clients may schedule or cancel deadlines from scheduledUpdate()
+void
+ClockScheduler::dispatch(
+    qint64 aNow)
+{
+    iWakeups.enqueue(aNow);
+    dropOldWakeups(aNow);
+    QVERBOSE(iDue.count() << "client(s)," << iWakeups.count() <<
+        "wakeups per minute");
+    while (!iDue.isEmpty()) {
+        iDue.takeFirst()->scheduledUpdate();
+    }
+}
+
+void
+ClockScheduler::timerEvent(
+    QTimerEvent* aEvent)
+{
+    if (aEvent->timerId() == iTimer.timerId()) {
+        const qint64 now = iClock.elapsed();
+        iTimer.stop();
+        for (int i = 0; i < iEntries.count(); i++) {
+            if (iEntries.at(i).second <= now + COALESCE_MS) {
+                iDue.append(iEntries.takeAt(i--).first);
+            }
+        }
+        dispatch(now);
+        restartTimer();
+    } else {
+        QObject::timerEvent(aEvent);
+    }
+}
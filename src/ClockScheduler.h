@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef CLOCK_SCHEDULER_H
+#define CLOCK_SCHEDULER_H
+
+#include "ClockTimeSource.h"
+
+#include <QObject>
+#include <QList>
+#include <QPair>
+#include <QQueue>
+#include <QBasicTimer>
+#include <QElapsedTimer>
+#include <QSharedPointer>
+
+// Single timer shared by all clocks and their layers. Each client has
+// at most one pending deadline. Deadlines which are close enough to each
+// other are served by the same wakeup, so e.g. the hour and minute hand
+// layers of all clocks (the cover and the page delegates) moving at the
+// top of the minute wake the process up once rather than once per layer.
+//
+// Deadlines at the top of a minute (that's when the hour and minute hands
+// move) are tracked by an absolute CLOCK_REALTIME timerfd, so they don't
+// drift and setting the system time cancels the timer and gets reported
+// to the time source right away. Local minutes are assumed to start at
+// the wall clock minutes, which is true for all current time zones.
+class QSocketNotifier;
+class ClockScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    class Client {
+    public:
+        virtual void scheduledUpdate() = 0;
+    protected:
+        virtual ~Client() {}
+    };
+
+    static QSharedPointer<ClockScheduler> sharedInstance();
+    ~ClockScheduler();
+
+    // Replaces the pending deadline of this client, if any. Clients
+    // must cancel their deadlines before being destroyed.
+    void schedule(Client* aClient, int aMsec);
+    // Same as the above, aMsec after aTime, unless that's the top of
+    // the minute which is waited for on the wall clock
+    void schedule(Client* aClient, int aMsec, const QTime& aTime);
+    void cancel(Client* aClient);
+    bool isScheduled(Client* aClient) const;
+
+    // Number of timer wakeups during the last 60 seconds, included in
+    // the CLOCK_FRAME_STATS output
+    int wakeupsPerMinute() const;
+
+protected:
+    void timerEvent(QTimerEvent* aEvent) Q_DECL_OVERRIDE;
+
+private Q_SLOTS:
+    void onMinuteTimer();
+
+private:
+    ClockScheduler();
+    void restartTimer();
+    void restartMinuteTimer();
+    void dropOldWakeups(qint64 aNow);
+    void dispatch(qint64 aNow);
+
+private:
+    typedef QPair<Client*, qint64> Entry;
+    QElapsedTimer iClock;
+    QBasicTimer iTimer;
+    qint64 iTimerDeadline;
+    QList<Entry> iEntries;
+    QSharedPointer<ClockTimeSource> iTimeSource;
+    QSocketNotifier* iMinuteNotifier;
+    int iMinuteTimerFd;
+    bool iMinuteTimerArmed;
+    QList<Client*> iMinuteClients;
+    QList<Client*> iDue;
+    QQueue<qint64> iWakeups;
+};
+
+#endif // CLOCK_SCHEDULER_H
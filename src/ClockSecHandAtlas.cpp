@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "ClockSecHandAtlas.h"
+#include "ClockDebug.h"
+
+#include <qmath.h>
+
+#define MAX_FRAMES  (720)
+#define MIN_FRAMES  (90)
+
+ClockSecHandAtlas::ClockSecHandAtlas() :
+    iRenderer(NULL),
+    iTheme(NULL),
+    iBudget(0)
+{
+}
+
+void
+ClockSecHandAtlas::invalidate()
+{
+    iRenderer = NULL;
+    iTheme = NULL;
+    iSize = QSize();
+    iBudget = 0;
+    iImage = QImage();
+    iBounds.clear();
+    iFrames.clear();
+    iPainted.clear();
+}
+
+bool
+ClockSecHandAtlas::setup(
+    ClockRenderer* aRenderer,
+    ClockTheme* aTheme,
+    const QSize& aSize,
+    int aBudget)
+{
+    if (iRenderer != aRenderer || iTheme != aTheme || iSize != aSize ||
+        iBudget != aBudget) {
+        invalidate();
+        iRenderer = aRenderer;
+        iTheme = aTheme;
+        iSize = aSize;
+        iBudget = aBudget;
+        if (aBudget > 0 && !aSize.isEmpty()) {
+            for (int n = MAX_FRAMES; n >= MIN_FRAMES && !layout(n); n /= 2);
+            if (isValid()) {
+                HDEBUG(aRenderer->id() << aSize << iFrames.count() <<
+                    "frames," << iImage.width() << "x" << iImage.height());
+            } else {
+                HDEBUG(aRenderer->id() << aSize << "doesn't fit in" <<
+                    aBudget << "bytes");
+            }
+        }
+    }
+    return isValid();
+}
+
+bool
+ClockSecHandAtlas::layout(
+    int aFrameCount)
+{
+    // Frame bounds (in item coordinates) and the total area
+    QVector<QRect> bounds;
+    qint64 area = 0;
+    int maxWidth = 0;
+    bounds.reserve(aFrameCount);
+    for (int i = 0; i < aFrameCount; i++) {
+        const QRect rect(iRenderer->secHandBounds(iSize, i*360.0/aFrameCount));
+        bounds.append(rect);
+        area += rect.width() * rect.height();
+        maxWidth = qMax(maxWidth, rect.width());
+    }
+
+    // Pack the frames in shelves
+    const int width = qMax(maxWidth, (int)ceil(sqrt(area)));
+    QVector<QRect> frames;
+    int x = 0, y = 0, shelf = 0;
+    frames.reserve(aFrameCount);
+    for (int i = 0; i < aFrameCount; i++) {
+        const QSize size(bounds.at(i).size());
+        if (x + size.width() > width) {
+            y += shelf;
+            x = shelf = 0;
+        }
+        frames.append(QRect(QPoint(x, y), size));
+        x += size.width();
+        shelf = qMax(shelf, size.height());
+    }
+
+    const int height = y + shelf;
+    if ((qint64)width * height * 4 > iBudget) {
+        return false;
+    }
+
+    // Frames get cleared when they are rendered
+    iImage = QImage(width, height, QImage::Format_ARGB32_Premultiplied);
+    if (iImage.isNull()) {
+        return false;
+    }
+    iBounds = bounds;
+    iFrames = frames;
+    iPainted = QBitArray(aFrameCount);
+    return true;
+}
+
+int
+ClockSecHandAtlas::frameIndex(
+    qreal aAngle) const
+{
+    const int n = iFrames.count();
+    const int i = qRound(aAngle * n / 360) % n;
+    return (i < 0) ? (i + n) : i;
+}
+
+QRect
+ClockSecHandAtlas::bounds(
+    qreal aAngle) const
+{
+    return iBounds.at(frameIndex(aAngle));
+}
+
+void
+ClockSecHandAtlas::paint(
+    QPainter* aPainter,
+    qreal aAngle)
+{
+    const int i = frameIndex(aAngle);
+    const QRect& frame(iFrames.at(i));
+    const QRect& bounds(iBounds.at(i));
+    if (!iPainted.testBit(i)) {
+        iPainted.setBit(i);
+        QPainter painter(&iImage);
+        painter.setClipRect(frame);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.fillRect(frame, Qt::transparent);
+        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setRenderHint(QPainter::HighQualityAntialiasing);
+        painter.translate(frame.topLeft() - bounds.topLeft());
+        iRenderer->paintSecHandAt(&painter, iSize, i*360.0/iFrames.count(),
+            iTheme);
+    }
+    aPainter->drawImage(bounds.topLeft(), iImage, frame);
+}
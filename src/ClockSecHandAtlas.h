@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef CLOCK_SEC_HAND_ATLAS_H
+#define CLOCK_SEC_HAND_ATLAS_H
+
+#include "ClockRenderer.h"
+
+#include <QBitArray>
+#include <QVector>
+#include <QImage>
+
+// Second hand pre-rendered at a fixed number of angles and packed into
+// a single image. Painting the hand then becomes a blit of the nearest
+// frame. The number of frames is reduced until the atlas fits into the
+// memory budget, and if even the minimal number of frames doesn't fit,
+// the atlas remains invalid and the hand has to be painted directly.
+// Frames are rendered on demand, the first time they are needed.
+class ClockSecHandAtlas
+{
+public:
+    ClockSecHandAtlas();
+
+    void invalidate();
+    bool isValid() const;
+
+    // Returns false if the atlas can't be used
+    bool setup(ClockRenderer* aRenderer, ClockTheme* aTheme,
+        const QSize& aSize, int aBudget);
+
+    // These require a valid atlas
+    QRect bounds(qreal aAngle) const;
+    void paint(QPainter* aPainter, qreal aAngle);
+
+    int frameCount() const;
+    int byteCount() const;
+
+private:
+    bool layout(int aFrameCount);
+    int frameIndex(qreal aAngle) const;
+
+private:
+    ClockRenderer* iRenderer;
+    ClockTheme* iTheme;
+    QSize iSize;
+    int iBudget;
+    QImage iImage;
+    QVector<QRect> iBounds;
+    QVector<QRect> iFrames;
+    QBitArray iPainted;
+};
+
+inline bool ClockSecHandAtlas::isValid() const
+    { return !iImage.isNull(); }
+inline int ClockSecHandAtlas::frameCount() const
+    { return iFrames.count(); }
+inline int ClockSecHandAtlas::byteCount() const
+    { return iImage.byteCount(); }
+
+#endif // CLOCK_SEC_HAND_ATLAS_H
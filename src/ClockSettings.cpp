@@ -47,9 +47,13 @@
 #define KEY_CLOCK_STYLE         "clockStyle"
 #define KEY_RENDER_TYPE         "renderType"
 #define KEY_ORIENTATION         "orientation"
+#define KEY_SEC_HAND_ATLAS_BUDGET "secHandAtlasBudget"
+#define KEY_MULTISAMPLING       "multisampling"
+#define KEY_AMBIENT_MODE        "ambientMode"
 
 #define DEFAULT_KEEP_DISPLAY_ON false
 #define DEFAULT_ORIENTATION     ClockSettings::OrientationPrimary
+#define DEFAULT_MULTISAMPLING   true
 
 #define SETTINGS_SHOW_NUMBERS   SETTINGS_GROUP KEY_SHOW_NUMBERS
 #define SETTINGS_INVERT_COLORS  SETTINGS_GROUP KEY_INVERT_COLORS
@@ -61,7 +65,10 @@ ClockSettings::ClockSettings(QObject* aParent) :
     iKeepDisplayOn(new MGConfItem(DCONF_(KEY_KEEP_DISPLAY_ON), this)),
     iClockStyle(new MGConfItem(DCONF_(KEY_CLOCK_STYLE), this)),
     iRenderType(new MGConfItem(DCONF_(KEY_RENDER_TYPE), this)),
-    iOrientation(new MGConfItem(DCONF_(KEY_ORIENTATION), this))
+    iOrientation(new MGConfItem(DCONF_(KEY_ORIENTATION), this)),
+    iSecHandAtlasBudget(new MGConfItem(DCONF_(KEY_SEC_HAND_ATLAS_BUDGET), this)),
+    iMultisampling(new MGConfItem(DCONF_(KEY_MULTISAMPLING), this)),
+    iAmbientMode(new MGConfItem(DCONF_(KEY_AMBIENT_MODE), this))
 {
     QTRACE("- created");
 
@@ -87,6 +94,9 @@ ClockSettings::ClockSettings(QObject* aParent) :
     connect(iClockStyle, SIGNAL(valueChanged()), SIGNAL(clockStyleChanged()));
     connect(iRenderType, SIGNAL(valueChanged()), SIGNAL(renderTypeChanged()));
     connect(iOrientation, SIGNAL(valueChanged()), SIGNAL(orientationChanged()));
+    connect(iSecHandAtlasBudget, SIGNAL(valueChanged()), SIGNAL(secHandAtlasBudgetChanged()));
+    connect(iMultisampling, SIGNAL(valueChanged()), SIGNAL(multisamplingChanged()));
+    connect(iAmbientMode, SIGNAL(valueChanged()), SIGNAL(ambientModeChanged()));
 }
 
 ClockSettings::~ClockSettings()
@@ -162,6 +172,42 @@ ClockSettings::orientation() const
     return DEFAULT_ORIENTATION;
 }
 
+// Memory budget for the pre-rendered second hand (in kilobytes),
+// zero disables the second hand atlas
+int
+ClockSettings::secHandAtlasBudget() const
+{
+    return qBound(0, iSecHandAtlasBudget->value(DEFAULT_SEC_HAND_ATLAS_BUDGET).
+        toInt(), MAX_SEC_HAND_ATLAS_BUDGET);
+}
+
+// Without multisampling, the scene graph nodes antialias their edges
+// themselves. Only takes effect after restart.
+bool
+ClockSettings::multisampling() const
+{
+    return iMultisampling->value(DEFAULT_MULTISAMPLING).toBool();
+}
+
+// In ambient mode the second hand is hidden and the clock is updated
+// once a minute. AmbientAuto enters it when the display gets dimmed or
+// turned off, or the device gets locked.
+ClockSettings::AmbientMode
+ClockSettings::ambientMode() const
+{
+    // Need to cast int to enum right away to force "enumeration value not
+    // handled in switch" warning if we miss one of the values:
+    ClockSettings::AmbientMode value = (ClockSettings::AmbientMode)
+        iAmbientMode->value(DEFAULT_AMBIENT_MODE).toInt();
+    switch (value) {
+    case AmbientOff:
+    case AmbientAuto:
+    case AmbientOn:
+        return value;
+    }
+    return DEFAULT_AMBIENT_MODE;
+}
+
 void
 ClockSettings::setShowNumbers(
     bool aValue)
@@ -48,6 +48,9 @@
 #define DEFAULT_INVERT_COLORS       false
 #define DEFAULT_CLOCK_STYLE         ClockRenderer::SWISS_RAILROAD
 #define DEFAULT_RENDER_TYPE         ClockSettings::RenderAuto
+#define DEFAULT_SEC_HAND_ATLAS_BUDGET 0
+#define MAX_SEC_HAND_ATLAS_BUDGET   (256*1024)
+#define DEFAULT_AMBIENT_MODE        ClockSettings::AmbientOff
 
 class QQmlEngine;
 class QJSEngine;
@@ -58,6 +61,7 @@ class ClockSettings : public QObject
     Q_OBJECT
     Q_ENUMS(RenderType)
     Q_ENUMS(Orientation)
+    Q_ENUMS(AmbientMode)
     Q_PROPERTY(bool showNumbers
                READ showNumbers
                WRITE setShowNumbers
@@ -80,6 +84,15 @@ class ClockSettings : public QObject
     Q_PROPERTY(int orientation
                READ orientation
                NOTIFY orientationChanged)
+    Q_PROPERTY(int secHandAtlasBudget
+               READ secHandAtlasBudget
+               NOTIFY secHandAtlasBudgetChanged)
+    Q_PROPERTY(bool multisampling
+               READ multisampling
+               NOTIFY multisamplingChanged)
+    Q_PROPERTY(int ambientMode
+               READ ambientMode
+               NOTIFY ambientModeChanged)
 
 public:
     enum RenderType {
@@ -97,6 +110,12 @@ public:
         OrientationAny
     };
 
+    enum AmbientMode {
+        AmbientOff,
+        AmbientAuto,
+        AmbientOn
+    };
+
     explicit ClockSettings(QObject* aParent = Q_NULLPTR);
     ~ClockSettings();
 
@@ -109,6 +128,9 @@ public:
     QString clockStyle() const;
     RenderType renderType() const;
     Orientation orientation() const;
+    int secHandAtlasBudget() const;
+    bool multisampling() const;
+    AmbientMode ambientMode() const;
 
     void setShowNumbers(bool);
     void setInvertColors(bool);
@@ -122,6 +144,9 @@ signals:
     void clockStyleChanged();
     void renderTypeChanged();
     void orientationChanged();
+    void secHandAtlasBudgetChanged();
+    void multisamplingChanged();
+    void ambientModeChanged();
 
 private:
     MGConfItem* iShowNumbers;
@@ -130,6 +155,9 @@ private:
     MGConfItem* iClockStyle;
     MGConfItem* iRenderType;
     MGConfItem* iOrientation;
+    MGConfItem* iSecHandAtlasBudget;
+    MGConfItem* iMultisampling;
+    MGConfItem* iAmbientMode;
 };
 
 #endif // CLOCK_SETTINGS_H
@@ -33,26 +33,33 @@
 
 #include "ClockTheme.h"
 
-ClockTheme* ClockTheme::newDefault()
+ClockTheme::ClockTheme(bool aInverted)
 {
-    ClockTheme* theme = new ClockTheme;
-    theme->iBackgroundColor.setRgb(228,228,228);
-    theme->iBackgroundColor1.setRgb(212,212,212);
-    theme->iBackgroundColor2.setRgb(43,43,43);
-    theme->iHourMinHandColor.setRgb(43,43,43);
-    theme->iHandShadowColor1.setRgb(228,228,228,0x40);
-    theme->iHandShadowColor2.setRgb(228,228,228,0x80);
-    return theme;
+    if (aInverted) {
+        iBackgroundColor.setRgb(43,43,43);
+        iBackgroundColor1.setRgb(86,86,86);
+        iBackgroundColor2.setRgb(43,43,43);
+        iHourMinHandColor.setRgb(228,228,228);
+        iHandShadowColor1.setRgb(43,43,43,0x80);
+        iHandShadowColor2.setRgb(43,43,43,0x40);
+    } else {
+        iBackgroundColor.setRgb(228,228,228);
+        iBackgroundColor1.setRgb(212,212,212);
+        iBackgroundColor2.setRgb(43,43,43);
+        iHourMinHandColor.setRgb(43,43,43);
+        iHandShadowColor1.setRgb(228,228,228,0x40);
+        iHandShadowColor2.setRgb(228,228,228,0x80);
+    }
 }
 
-ClockTheme* ClockTheme::newInverted()
+ClockTheme* ClockTheme::defaultTheme()
 {
-    ClockTheme* theme = new ClockTheme;
-    theme->iBackgroundColor.setRgb(43,43,43);
-    theme->iBackgroundColor1.setRgb(86,86,86);
-    theme->iBackgroundColor2.setRgb(43,43,43);
-    theme->iHourMinHandColor.setRgb(228,228,228);
-    theme->iHandShadowColor1.setRgb(43,43,43,0x80);
-    theme->iHandShadowColor2.setRgb(43,43,43,0x40);
-    return theme;
+    static ClockTheme theme(false);
+    return &theme;
+}
+
+ClockTheme* ClockTheme::invertedTheme()
+{
+    static ClockTheme theme(true);
+    return &theme;
 }
@@ -47,11 +47,12 @@ public:
     QColor iHandShadowColor2;
     QColor iDialShadowColor;
 
-    static ClockTheme* newDefault();
-    static ClockTheme* newInverted();
+    // Shared by all clocks
+    static ClockTheme* defaultTheme();
+    static ClockTheme* invertedTheme();
 
 private:
-    ClockTheme() {}
+    ClockTheme(bool aInverted);
 };
 
 #endif // CLOCK_THEME_H
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "ClockTimeSource.h"
+#include "ClockDebug.h"
+
+#include <QDateTime>
+#include <QTimeZone>
+#include <QTimerEvent>
+#include <QDBusConnection>
+
+#include <stdlib.h>
+#include <time.h>
+
+#define MSECS_PER_DAY (86400000)
+
+// Smaller jumps are just the two clocks drifting apart
+#define JUMP_THRESHOLD_MS (50)
+
+// Even without DST, the offset gets refreshed once a day
+#define MAX_TRANSITION_CHECK_MS (MSECS_PER_DAY)
+
+// timed emits this when the system time or time zone changes
+#define TIMED_SERVICE "com.nokia.time"
+#define TIMED_PATH "/com/nokia/time"
+#define TIMED_INTERFACE "com.nokia.time"
+#define TIMED_SETTINGS_CHANGED "settings_changed"
+
+// ==========================================================================
+// ClockTimeSource::Fixed
+// ==========================================================================
+
+// Always returns the same time
+class ClockTimeSource::Fixed : public ClockTimeSource
+{
+public:
+    Fixed(const QTime& aTime) : iTime(aTime) {}
+    QTime currentTime() const Q_DECL_OVERRIDE { return iTime; }
+    void refresh() Q_DECL_OVERRIDE {}
+
+private:
+    const QTime iTime;
+};
+
+// ==========================================================================
+// ClockTimeSource
+// ==========================================================================
+
+static QWeakPointer<ClockTimeSource> clockTimeSourceSharedInstance;
+
+ClockTimeSource::ClockTimeSource() :
+    iOffset(localMsecsSinceEpoch() - monotonicMsecs())
+{
+    QDBusConnection::systemBus().connect(TIMED_SERVICE, TIMED_PATH,
+        TIMED_INTERFACE, TIMED_SETTINGS_CHANGED, this, SLOT(refresh()));
+    scheduleTransition();
+}
+
+ClockTimeSource::~ClockTimeSource()
+{
+    QDBusConnection::systemBus().disconnect(TIMED_SERVICE, TIMED_PATH,
+        TIMED_INTERFACE, TIMED_SETTINGS_CHANGED, this, SLOT(refresh()));
+}
+
+#if HARBOUR_DEBUG
+static QSharedPointer<ClockTimeSource>
+clockFixedTimeSource()
+{
+    QSharedPointer<ClockTimeSource> source;
+    const char* fixedTimeString = getenv("QUICK_CLOCK_TIME");
+    if (fixedTimeString) {
+        QTime fixedTime(QTime::fromString(fixedTimeString, "h:mm:s"));
+        if (!fixedTime.isValid()) {
+            fixedTime = QTime::fromString(fixedTimeString, "h:mm:s.z");
+        }
+        if (fixedTime.isValid()) {
+            HDEBUG("Fixed" << fixedTime);
+            source = ClockTimeSource::fixed(fixedTime);
+        } else {
+            HWARN("Invalid time string " << fixedTimeString);
+        }
+    }
+    return source;
+}
+#endif
+
+QSharedPointer<ClockTimeSource>
+ClockTimeSource::sharedInstance()
+{
+    QSharedPointer<ClockTimeSource> instance = clockTimeSourceSharedInstance;
+    if (instance.isNull()) {
+#if HARBOUR_DEBUG
+        instance = clockFixedTimeSource();
+#endif
+        if (instance.isNull()) {
+            // QSharedPointer::create() can't access the protected constructor
+            instance = QSharedPointer<ClockTimeSource>(new ClockTimeSource);
+        }
+        clockTimeSourceSharedInstance = instance;
+    }
+    return instance;
+}
+
+QSharedPointer<ClockTimeSource>
+ClockTimeSource::fixed(
+    const QTime& aTime)
+{
+    return QSharedPointer<ClockTimeSource>(new Fixed(aTime));
+}
+
+void
+ClockTimeSource::setSharedInstance(
+    QSharedPointer<ClockTimeSource> aSource)
+{
+    clockTimeSourceSharedInstance = aSource;
+}
+
+qint64
+ClockTimeSource::monotonicMsecs()
+{
+    // Unlike CLOCK_MONOTONIC, CLOCK_BOOTTIME keeps counting while the
+    // device is suspended
+    struct timespec ts;
+#ifdef CLOCK_BOOTTIME
+    clock_gettime(CLOCK_BOOTTIME, &ts);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return qint64(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+qint64
+ClockTimeSource::localMsecsSinceEpoch()
+{
+    const QDateTime now(QDateTime::currentDateTime());
+    return now.toMSecsSinceEpoch() + qint64(now.offsetFromUtc()) * 1000;
+}
+
+QTime
+ClockTimeSource::currentTime() const
+{
+    qint64 ms = (monotonicMsecs() + iOffset.load()) % MSECS_PER_DAY;
+    if (ms < 0) ms += MSECS_PER_DAY;
+    return QTime::fromMSecsSinceStartOfDay((int)ms);
+}
+
+void
+ClockTimeSource::refresh()
+{
+    const qint64 offset = localMsecsSinceEpoch() - monotonicMsecs();
+    const qint64 prev = iOffset.fetchAndStoreOrdered(offset);
+    scheduleTransition();
+    if (qAbs(offset - prev) > JUMP_THRESHOLD_MS) {
+        HDEBUG("Time jumped by" << (offset - prev) << "ms");
+        Q_EMIT timeChanged();
+    }
+}
+
+// Wakes up at the next DST transition (or in a day)
+void
+ClockTimeSource::scheduleTransition()
+{
+    const QDateTime now(QDateTime::currentDateTimeUtc());
+    const QTimeZone::OffsetData next(QTimeZone::systemTimeZone().
+        nextTransition(now));
+    qint64 ms = MAX_TRANSITION_CHECK_MS;
+    if (next.atUtc.isValid()) {
+        ms = qBound(Q_INT64_C(1000), now.msecsTo(next.atUtc) + 1,
+            qint64(MAX_TRANSITION_CHECK_MS));
+    }
+    iTransitionTimer.start((int)ms, Qt::VeryCoarseTimer, this);
+}
+
+void
+ClockTimeSource::timerEvent(
+    QTimerEvent* aEvent)
+{
+    if (aEvent->timerId() == iTransitionTimer.timerId()) {
+        refresh();
+    } else {
+        QObject::timerEvent(aEvent);
+    }
+}
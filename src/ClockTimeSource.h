@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef CLOCK_TIME_SOURCE_H
+#define CLOCK_TIME_SOURCE_H
+
+#include <QObject>
+#include <QTime>
+#include <QAtomicInteger>
+#include <QBasicTimer>
+#include <QSharedPointer>
+
+// Local time as a monotonic clock plus a cached offset, so that reading
+// the time doesn't involve time zone conversion. The offset is refreshed
+// when timed reports that the system time or the time zone has changed,
+// at DST transitions and whenever refresh() is called. timeChanged() is
+// emitted if the offset actually jumps.
+//
+// currentTime() is thread-safe, it gets called on the render thread.
+//
+// The shared instance can be replaced (e.g. with a fixed or simulated
+// clock) by setSharedInstance(), clocks created after that are going to
+// use it. In debug builds, QUICK_CLOCK_TIME environment variable (h:mm:s
+// or h:mm:s.z) makes the default instance fixed().
+class ClockTimeSource : public QObject
+{
+    Q_OBJECT
+
+public:
+    static QSharedPointer<ClockTimeSource> sharedInstance();
+    static void setSharedInstance(QSharedPointer<ClockTimeSource> aSource);
+    static QSharedPointer<ClockTimeSource> fixed(const QTime& aTime);
+    ~ClockTimeSource();
+
+    virtual QTime currentTime() const;
+
+public Q_SLOTS:
+    virtual void refresh();
+
+Q_SIGNALS:
+    void timeChanged();
+
+protected:
+    ClockTimeSource();
+    void timerEvent(QTimerEvent* aEvent) Q_DECL_OVERRIDE;
+
+private:
+    static qint64 monotonicMsecs();
+    static qint64 localMsecsSinceEpoch();
+    void scheduleTransition();
+
+private:
+    class Fixed;
+    QAtomicInteger<qint64> iOffset;
+    QBasicTimer iTransitionTimer;
+};
+
+#endif // CLOCK_TIME_SOURCE_H
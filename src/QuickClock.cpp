@@ -52,34 +52,41 @@
 QuickClock::QuickClock(QQuickItem* aParent) :
     SUPER(aParent),
     iSystemState(HarbourSystemState::sharedInstance()),
+    iScheduler(ClockScheduler::sharedInstance()),
+    iTimeSource(ClockTimeSource::sharedInstance()),
+    iDialCache(ClockDialCache::sharedInstance()),
     iRenderType(DEFAULT_RENDER_TYPE),
     iInvertColors(DEFAULT_INVERT_COLORS),
     iDrawBackground(true),
     iOptimized(false),
     iRunning(true),
     iRepaintAll(true),
-    iThemeDefault(ClockTheme::newDefault()),
-    iThemeInverted(ClockTheme::newInverted()),
+    iSecHandAtlasBudget(DEFAULT_SEC_HAND_ATLAS_BUDGET),
+    iAmbientMode(DEFAULT_AMBIENT_MODE),
+    iAmbient(false),
+    iWakeups(0),
+    iRenders(0),
+    iSuspendedWakeups(0),
+    iSuspendedRenders(0),
     iRenderer(NULL),
     iLayers(NULL),
-    iDialPlatePixmap(NULL),
-    iHourMinPixmap(NULL),
-    iPaintHour(0),
-    iPaintMinute(0)
+    iFrameDriver(new ClockFrameDriver(this)),
+    iFrameStats(ClockFrameStats::create(this)),
+    iDialPlatePixmap(NULL)
 {
     QTRACE("- created");
     setFlags(ItemHasContents);
 
-    iRenderers.append(ClockRenderer::newSwissRailroad());
-    iRenderers.append(ClockRenderer::newHelsinkiMetro());
-    iRenderers.append(ClockRenderer::newDeutscheBahn());
     setStyle(DEFAULT_CLOCK_STYLE);
 
     iUpdatesEnabled = updatesEnabled();
-    connect(iSystemState.data(), SIGNAL(lockModeChanged()), SLOT(checkUpdatesEnabled()));
     connect(iSystemState.data(), SIGNAL(displayStatusChanged()), SLOT(checkUpdatesEnabled()));
+    connect(iSystemState.data(), SIGNAL(lockModeChanged()), SLOT(checkAmbient()));
+    connect(iSystemState.data(), SIGNAL(displayStatusChanged()), SLOT(checkAmbient()));
     connect(this, SIGNAL(widthChanged()), SLOT(onWidthChanged()));
+    connect(iFrameDriver, SIGNAL(frame()), SLOT(onFrame()));
     connect(this, SIGNAL(heightChanged()), SLOT(onHeightChanged()));
+    connect(iTimeSource.data(), SIGNAL(timeChanged()), SLOT(onTimeChanged()));
     updateRenderingType();
     setRunning(true);
 }
@@ -87,38 +94,8 @@ QuickClock::QuickClock(QQuickItem* aParent) :
 QuickClock::~QuickClock()
 {
     QTRACE("- destroyed");
-    delete iDialPlatePixmap;
-    delete iHourMinPixmap;
-    delete iThemeDefault;
-    delete iThemeInverted;
-    qDeleteAll(iRenderers);
-}
-
-QTime
-QuickClock::currentTime()
-{
-#if HARBOUR_DEBUG
-    static const char FIXED_TIME_UNINITIALIZED[] = "";
-    static const char* fixedTimeString = FIXED_TIME_UNINITIALIZED;
-    static QTime fixedTime;
-    if (fixedTimeString == FIXED_TIME_UNINITIALIZED) {
-        fixedTimeString = getenv("QUICK_CLOCK_TIME");
-        if (fixedTimeString) {
-            fixedTime = QTime::fromString(fixedTimeString, "h:mm:s");
-            if (!fixedTime.isValid()) {
-                fixedTime = QTime::fromString(fixedTimeString, "h:mm:s.z");
-            }
-            if (fixedTime.isValid()) {
-                HDEBUG("Fixed" << fixedTime);
-            } else {
-                HWARN("Invalid time string " << fixedTimeString);
-                fixedTimeString = NULL;
-            }
-        }
-    }
-    if (fixedTimeString) return fixedTime;
-#endif
-    return QTime::currentTime();
+    iScheduler->cancel(this);
+    releaseDialPlatePixmap();
 }
 
 void
@@ -150,29 +127,32 @@ QuickClock::setStyle(
     QString aValue)
 {
     if (aValue.isEmpty()) aValue = DEFAULT_CLOCK_STYLE;
-    for (int i=0; i<iRenderers.count(); i++) {
-        ClockRenderer* renderer = iRenderers.at(i);
-        if (renderer->id() == aValue) {
-            QTRACE("style = " << aValue);
-            if (iRenderer != renderer) {
-                iRenderer = renderer;
-                Q_EMIT styleChanged();
-                iRepaintAll = true;
-                QTRACE("- requesting update");
-                requestUpdate(true);
+    ClockRenderer* renderer = ClockRenderer::find(aValue);
+    if (renderer) {
+        QTRACE("style = " << aValue);
+        if (iRenderer != renderer) {
+            iRenderer = renderer;
+            if (iFrameStats) {
+                iFrameStats->setName(QString("%1 %2").arg(aValue).
+                    arg((quintptr)this, 0, 16));
             }
-            return;
+            Q_EMIT styleChanged();
+            iRepaintAll = true;
+            QTRACE("- requesting update");
+            requestUpdate(true);
         }
+    } else {
+        QTRACE("unknown style" << aValue);
+        if (!iRenderer) iRenderer = ClockRenderer::find(DEFAULT_CLOCK_STYLE);
     }
-    QTRACE("unknown style" << aValue);
-    if (!iRenderer) iRenderer = iRenderers.at(0);
 }
 
 
 bool
 QuickClock::updatesEnabled() const
 {
-    return iRunning && (!iSystemState->displayOff() || !iSystemState->locked());
+    // Nobody sees the frames while the display is off, locked or not
+    return iRunning && !iSystemState->displayOff();
 }
 
 void
@@ -181,16 +161,58 @@ QuickClock::checkUpdatesEnabled()
     if (updatesEnabled()) {
         if (!iUpdatesEnabled) {
             iUpdatesEnabled = true;
+            if (iSuspendedWakeups || iSuspendedRenders) {
+                HWARN(iSuspendedWakeups << "wakeups and" <<
+                    iSuspendedRenders << "renders while updates were off");
+            }
+            // The time may have been set while we weren't looking
+            iTimeSource->refresh();
+            // Whatever was scheduled before is outdated. The next frame
+            // is rendered in full at the current time, before anything
+            // else gets a chance to show the hands where they were.
+            iPaintTime = QTime();
             QTRACE("- requesting update");
             requestUpdate(false);
+            onUpdated();
             Q_EMIT updatesEnabledChanged();
         }
     } else if (iUpdatesEnabled) {
         iUpdatesEnabled = false;
+        QTRACE("- stopping updates");
+        iScheduler->cancel(this);
+        iFrameDriver->cancel();
         Q_EMIT updatesEnabledChanged();
     }
 }
 
+// Activity counters. Updates are supposed to be completely suspended
+// while the display is off, these make sure that they actually are.
+// The counters are never reset, clockbench checks them and they are
+// included in the CLOCK_FRAME_STATS output.
+void
+QuickClock::countWakeup()
+{
+    iWakeups++;
+    if (!iUpdatesEnabled) {
+        iSuspendedWakeups++;
+    }
+    if (iFrameStats) {
+        iFrameStats->recordWakeup(!iUpdatesEnabled);
+    }
+}
+
+void
+QuickClock::countRender()
+{
+    iRenders++;
+    if (!iUpdatesEnabled) {
+        iSuspendedRenders++;
+    }
+    if (iFrameStats) {
+        iFrameStats->recordRender(!iUpdatesEnabled);
+    }
+}
+
 void
 QuickClock::setRenderType(
     int aValue)
@@ -212,6 +234,69 @@ QuickClock::setRenderType(
     }
 }
 
+// The budget is in kilobytes, zero disables the atlas. It's clamped so
+// that it still fits into an int when converted to bytes.
+void
+QuickClock::setSecHandAtlasBudget(
+    int aValue)
+{
+    const int budget = qBound(0, aValue, MAX_SEC_HAND_ATLAS_BUDGET);
+    QTRACE("-" << budget);
+    if (iSecHandAtlasBudget != budget) {
+        iSecHandAtlasBudget = budget;
+        Q_EMIT secHandAtlasBudgetChanged();
+        requestUpdate(false);
+    }
+}
+
+void
+QuickClock::setAmbientMode(
+    int aValue)
+{
+    ClockSettings::AmbientMode mode = DEFAULT_AMBIENT_MODE;
+    switch ((ClockSettings::AmbientMode)aValue) {
+    case ClockSettings::AmbientOff:
+    case ClockSettings::AmbientAuto:
+    case ClockSettings::AmbientOn:
+        mode = (ClockSettings::AmbientMode)aValue;
+        break;
+    }
+
+    QTRACE("-" << aValue);
+    if (iAmbientMode != mode) {
+        iAmbientMode = mode;
+        Q_EMIT ambientModeChanged();
+        checkAmbient();
+    }
+}
+
+void
+QuickClock::checkAmbient()
+{
+    bool ambient = false;
+    switch (iAmbientMode) {
+    case ClockSettings::AmbientOff:
+        break;
+    case ClockSettings::AmbientAuto:
+        ambient = iSystemState->locked() || iSystemState->displayOff() ||
+            iSystemState->displayStatus() ==
+                HarbourSystemState::MCE_DISPLAY_DIM;
+        break;
+    case ClockSettings::AmbientOn:
+        ambient = true;
+        break;
+    }
+
+    if (iAmbient != ambient) {
+        iAmbient = ambient;
+        QTRACE("- ambient" << ambient);
+        Q_EMIT ambientChanged();
+        // Show or hide the second hand and reschedule the updates
+        requestUpdate(false);
+        onUpdated();
+    }
+}
+
 void
 QuickClock::setRunning(
     bool aRunning)
@@ -244,15 +329,27 @@ QuickClock::updateRenderingType()
         iOptimized = optimized;
         QTRACE("- switched to" << (optimized ? "optimized" : "non-optimized"));
         if (iOptimized) {
+            // Everything including the dial plate is in the scene graph,
+            // the painted item itself has nothing to show
+            new QuickClockLayer(
             new QuickClockLayer(
             new QuickClockLayer(iLayers =
             new QuickClockLayer(this,
+                this, ClockRenderer::NodeDial),
                 this, ClockRenderer::NodeHour),
                 this, ClockRenderer::NodeMin),
                 this, ClockRenderer::NodeSec);
+            setFlag(ItemHasContents, false);
+            iFrameDriver->cancel();
+            releaseDialPlatePixmap();
+            iHourMinLayer.release();
+            iSecHandAtlas.invalidate();
+            iSecHandRect = QRect();
+            iPaintTime = QTime();
         } else {
             delete iLayers;
             iLayers = NULL;
+            setFlag(ItemHasContents);
         }
         onUpdated();
         requestUpdate(true);
@@ -280,18 +377,11 @@ QuickClock::onHeightChanged()
 }
 
 void
-QuickClock::timerEvent(
-    QTimerEvent* aEvent)
+QuickClock::scheduledUpdate()
 {
-    if (aEvent->timerId() == iRepaintTimer.timerId()) {
-        if (updatesEnabled()) {
-            requestUpdate(false);
-        } else {
-            QTRACE("- stopping updates");
-            iRepaintTimer.stop();
-        }
-    } else {
-        SUPER::timerEvent(aEvent);
+    countWakeup();
+    if (updatesEnabled()) {
+        updateSecHand();
     }
 }
 
@@ -299,13 +389,44 @@ void
 QuickClock::requestUpdate(
     bool aFullUpdate)
 {
-    if (aFullUpdate) {
-        if (!iRepaintAll) {
-            iRepaintAll = true;
-            Q_EMIT fullUpdateRequested();
-        }
+    // In optimized mode paint() isn't called and iRepaintAll is never
+    // reset, the layers need to be told every time
+    if (aFullUpdate && (!iRepaintAll || iOptimized)) {
+        iRepaintAll = true;
+        Q_EMIT fullUpdateRequested();
+    }
+    if (!iOptimized) {
+        update();
+    }
+}
+
+void
+QuickClock::updateSecHand()
+{
+    // Unless something else has changed, only the area swept by the
+    // second hand needs to be repainted. The time is remembered so that
+    // the hand gets painted exactly where we expect it to be.
+    const QSize size(paintSize());
+    const QTime time(iFrameDriver->presentTime());
+    if (!iRepaintAll && !iOptimized && iSecHandRect.isValid() &&
+        iHourMinLayer.isValid(iRenderer, size, time)) {
+        iPaintTime = time;
+        update(iSecHandRect.united(secHandBounds(size, time)));
+    } else {
+        iPaintTime = QTime();
+        update();
     }
-    update();
+}
+
+QRect
+QuickClock::secHandBounds(
+    const QSize& aSize,
+    const QTime& aTime) const
+{
+    // The atlas may have the hand at a slightly different angle
+    const qreal angle = iRenderer->nodeAngle(ClockRenderer::NodeSec, aTime);
+    return iSecHandAtlas.isValid() ? iSecHandAtlas.bounds(angle) :
+        iRenderer->secHandBounds(aSize, angle);
 }
 
 void
@@ -313,64 +434,85 @@ QuickClock::paintDialPlatePixmap(
     const QSize& aSize)
 {
     if (!iDialPlatePixmap || iDialPlatePixmap->size() != aSize) {
-        delete iDialPlatePixmap;
-        iDialPlatePixmap = new QPixmap(aSize);
-        HDEBUG("drawing dial plate" << aSize.width() << "x" << aSize.height());
-        iDialPlatePixmap->fill(Qt::transparent);
-        QPainter painter(iDialPlatePixmap);
-        painter.setRenderHint(QPainter::Antialiasing);
-        painter.setRenderHint(QPainter::HighQualityAntialiasing);
-        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
-        iRenderer->paintDialPlate(&painter, aSize, theme(), iDrawBackground);
+        releaseDialPlatePixmap();
+        iDialPlatePixmap = iDialCache->acquire(iRenderer, aSize, theme(),
+            iDrawBackground);
     }
 }
 
 void
-QuickClock::paintOffScreenNoSec(
-    QPainter* aPainter,
-    const QSize& aSize,
-    const QTime& aTime)
+QuickClock::releaseDialPlatePixmap()
 {
-    paintDialPlatePixmap(aSize);
-    aPainter->drawPixmap(0, 0, *iDialPlatePixmap);
-    aPainter->save();
-    aPainter->setRenderHint(QPainter::Antialiasing);
-    aPainter->setRenderHint(QPainter::HighQualityAntialiasing);
-    aPainter->setCompositionMode(QPainter::CompositionMode_SourceOver);
-    iRenderer->paintHourMinHands(aPainter, aSize, aTime, theme());
-    aPainter->restore();
+    if (iDialPlatePixmap) {
+        iDialCache->release(iDialPlatePixmap);
+        iDialPlatePixmap = NULL;
+    }
 }
 
-void
-QuickClock::repaintHourMin(
-    const QSize& aSize,
-    const QTime& aTime)
+// In ambient mode the second hand is hidden and the hour and minute hands
+// only get updated at the top of the minute (and while the minute hand is
+// moving to its new position)
+int
+QuickClock::msecUntilNextUpdate(
+    ClockRenderer::NodeType aType,
+    const QTime& aTime) const
+{
+    if (iAmbient && aType == ClockRenderer::NodeSec) {
+        // No second hand in ambient mode
+        return -1;
+    } else {
+        // The motion profile knows when the hand moves next
+        return iRenderer->msecUntilNextUpdate(aType, aTime);
+    }
+}
+
+// Expected interval between animation frames, in milliseconds
+int
+QuickClock::frameInterval() const
 {
-    delete iHourMinPixmap;
-    iHourMinPixmap = new QPixmap(aSize);
-    iHourMinPixmap->fill(Qt::transparent);
-    QPainter painter(iHourMinPixmap);
-    QVERBOSE("- drawing hour and minute hands" <<
-        qPrintable(aTime.toString("hh:mm:ss.zzz")));
-    paintOffScreenNoSec(&painter, aSize, aTime);
+    const qreal rate = iFrameDriver->refreshRate();
+    return (rate > 0) ? qMax(qRound(1000 / rate), 1) : minUpdateInterval();
 }
 
 int
 QuickClock::minUpdateInterval() const
 {
-    return iSystemState->displayOff() ?
-        QUICK_CLOCK_MIN_UPDATE_INTERVAL_DISPLAY_OFF:
-        QUICK_CLOCK_MIN_UPDATE_INTERVAL_DISPLAY_ON;
+    return QUICK_CLOCK_MIN_UPDATE_INTERVAL;
 }
 
 void
 QuickClock::onUpdated()
 {
-    if (iOptimized) {
+    if (iOptimized || !updatesEnabled()) {
         QTRACE("- stopping updates");
-        iRepaintTimer.stop();
+        iScheduler->cancel(this);
+    } else if (iAmbient) {
+        const QTime time(currentTime());
+        const int msec = msecUntilNextUpdate(ClockRenderer::NodeMin, time);
+        iScheduler->schedule(this, qMax(msec, minUpdateInterval()), time);
     } else {
-        iRepaintTimer.start(minUpdateInterval(), this);
+        iScheduler->schedule(this, minUpdateInterval());
+    }
+}
+
+void
+QuickClock::onTimeChanged()
+{
+    // The system time or the time zone has changed. The hour and minute
+    // hands may have to jump, and the timers are aiming at the wrong time.
+    QTRACE("- time changed");
+    iPaintTime = QTime();
+    requestUpdate(true);
+    onUpdated();
+}
+
+void
+QuickClock::onFrame()
+{
+    // The previous frame has been swapped, the timer isn't needed
+    iScheduler->cancel(this);
+    if (updatesEnabled()) {
+        updateSecHand();
     }
 }
 
@@ -378,40 +520,64 @@ void
 QuickClock::paint(
     QPainter* aPainter)
 {
-    const int w = (int)width() & ~1;
-    const int h = (int)height() & ~1;
-    QSize size(w, h);
+    const QSize size(paintSize());
+    const qint64 start = iFrameStats ? iFrameStats->now() : 0;
 
+    countRender();
     if (iRepaintAll) {
         iRepaintAll = false;
-        delete iDialPlatePixmap;
-        iDialPlatePixmap = NULL;
+        releaseDialPlatePixmap();
+        iHourMinLayer.invalidate();
     }
 
-    if (iOptimized) {
-        QVERBOSE("- rendering");
-        paintDialPlatePixmap(size);
-        aPainter->drawPixmap(0, 0, *iDialPlatePixmap);
+    // Only the raster path gets here, in optimized mode the item has
+    // no contents of its own
+    paintDialPlatePixmap(size);
+    const QTime time(iPaintTime.isValid() ? iPaintTime :
+        iFrameDriver->presentTime());
+    QVERBOSE("- rendering" << qPrintable(time.toString("hh:mm:ss.zzz")));
+    iPaintTime = QTime();
+    iHourMinLayer.update(iRenderer, theme(), iDialPlatePixmap, size, time);
+    if (aPainter->hasClipping()) {
+        // Partial update, QQuickPaintedItem has already set the clip
+        const QRect rect(aPainter->clipBoundingRect().toAlignedRect());
+        aPainter->drawPixmap(rect.topLeft(), *iHourMinLayer.pixmap(), rect);
+    } else {
+        aPainter->drawPixmap(0, 0, *iHourMinLayer.pixmap());
+    }
+    if (iAmbient) {
+        // No second hand in ambient mode
+        iSecHandRect = QRect();
     } else {
-        QTime time = currentTime();
-        QVERBOSE("- rendering" << qPrintable(time.toString("hh:mm:ss.zzz")));
-        if (!iDialPlatePixmap ||
-           (time.second() == 0 ||
-            time.minute() != iPaintTimeNoSec.minute() ||
-            time.hour() != iPaintTimeNoSec.hour())) {
-            repaintHourMin(size, time);
-        }
-        aPainter->drawPixmap(0, 0, *iHourMinPixmap);
         aPainter->save();
-        aPainter->setRenderHint(QPainter::Antialiasing);
-        aPainter->setRenderHint(QPainter::HighQualityAntialiasing);
         aPainter->setCompositionMode(QPainter::CompositionMode_SourceOver);
-        iRenderer->paintSecHand(aPainter, size, time, theme());
+        if (iSecHandAtlas.setup(iRenderer, theme(), size,
+            iSecHandAtlasBudget * 1024)) {
+            iSecHandAtlas.paint(aPainter,
+                iRenderer->nodeAngle(ClockRenderer::NodeSec, time));
+        } else {
+            aPainter->setRenderHint(QPainter::Antialiasing);
+            aPainter->setRenderHint(QPainter::HighQualityAntialiasing);
+            iRenderer->paintSecHand(aPainter, size, time, theme());
+        }
+        iSecHandRect = secHandBounds(size, time);
+        if (iFrameStats) {
+            iFrameStats->recordSecHand(iRenderer,
+                iRenderer->nodeAngle(ClockRenderer::NodeSec, time), time);
+        }
         aPainter->restore();
-        CLOCK_PERFORMANCE_LOG_RECORD;
     }
-
-    if (!iOptimized) {
+    CLOCK_PERFORMANCE_LOG_RECORD;
+    if (!iAmbient && iFrameDriver->isActive() && updatesEnabled()) {
+        // Repaint the second hand as soon as this frame gets swapped
+        iFrameDriver->requestFrame();
+        if (iFrameStats) {
+            iFrameStats->recordFrame(start, frameInterval());
+        }
+    } else {
         QMetaObject::invokeMethod(this, "onUpdated", Qt::QueuedConnection);
+        if (iFrameStats) {
+            iFrameStats->recordFrame(start, 0);
+        }
     }
 }
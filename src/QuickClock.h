@@ -34,14 +34,20 @@
 #ifndef QUICK_CLOCK_H
 #define QUICK_CLOCK_H
 
+#include "ClockDialCache.h"
+#include "ClockFrameDriver.h"
+#include "ClockFrameStats.h"
+#include "ClockHourMinLayer.h"
 #include "ClockRenderer.h"
+#include "ClockScheduler.h"
+#include "ClockSecHandAtlas.h"
 #include "ClockSettings.h"
 #include "ClockTheme.h"
+#include "ClockTimeSource.h"
 #include "ClockDebug.h"
 
 #include "HarbourSystemState.h"
 
-#include <QBasicTimer>
 #include <QQuickPaintedItem>
 #include <QDateTime>
 #include <QPainter>
@@ -50,7 +56,7 @@
 
 class QuickClockLayer;
 
-class QuickClock: public QQuickPaintedItem
+class QuickClock: public QQuickPaintedItem, public ClockScheduler::Client
 {
     Q_OBJECT
     Q_PROPERTY(bool running READ running WRITE setRunning NOTIFY runningChanged)
@@ -58,6 +64,9 @@ class QuickClock: public QQuickPaintedItem
     Q_PROPERTY(bool drawBackground READ drawBackground WRITE setDrawBackground NOTIFY drawBackgroundChanged)
     Q_PROPERTY(int renderType READ renderType WRITE setRenderType NOTIFY renderTypeChanged)
     Q_PROPERTY(QString style READ style WRITE setStyle NOTIFY styleChanged)
+    Q_PROPERTY(int secHandAtlasBudget READ secHandAtlasBudget WRITE setSecHandAtlasBudget NOTIFY secHandAtlasBudgetChanged)
+    Q_PROPERTY(int ambientMode READ ambientMode WRITE setAmbientMode NOTIFY ambientModeChanged)
+    Q_PROPERTY(bool ambient READ ambient NOTIFY ambientChanged)
 
 public:
     explicit QuickClock(QQuickItem* aParent = Q_NULLPTR);
@@ -78,18 +87,38 @@ public:
     QString style() const;
     void setStyle(QString);
 
+    int secHandAtlasBudget() const;
+    void setSecHandAtlasBudget(int);
+
+    int ambientMode() const;
+    void setAmbientMode(int);
+    bool ambient() const;
+
     bool updatesEnabled() const;
     int minUpdateInterval() const;
+    int msecUntilNextUpdate(ClockRenderer::NodeType, const QTime&) const;
+
+    void countWakeup();
+    void countRender();
+    int wakeups() const;
+    int renders() const;
+    int suspendedWakeups() const;
+    int suspendedRenders() const;
+    ClockFrameStats* frameStats() const;
+    int frameInterval() const;
     ClockRenderer* renderer() const;
     ClockTheme* theme() const;
 
-    static QTime currentTime();
+    QTime currentTime() const;
 
 Q_SIGNALS:
     void invertColorsChanged();
     void drawBackgroundChanged();
     void renderTypeChanged();
     void styleChanged();
+    void secHandAtlasBudgetChanged();
+    void ambientModeChanged();
+    void ambientChanged();
     void runningChanged();
     void updatesEnabledChanged();
     void fullUpdateRequested();
@@ -98,22 +127,30 @@ private Q_SLOTS:
     void onWidthChanged();
     void onHeightChanged();
     void checkUpdatesEnabled();
+    void checkAmbient();
     void onUpdated();
+    void onFrame();
+    void onTimeChanged();
 
 protected:
     virtual void paint(QPainter*);
-    virtual void timerEvent(QTimerEvent*);
+    void scheduledUpdate() Q_DECL_OVERRIDE;
 
 private:
     bool updateRenderingType();
     void requestUpdate(bool);
+    void updateSecHand();
+    QRect secHandBounds(const QSize&, const QTime&) const;
+    QSize paintSize() const;
     void paintDialPlatePixmap(const QSize&);
-    void paintOffScreenNoSec(QPainter*, const QSize&, const QTime&);
-    void repaintHourMin(const QSize&, const QTime&);
+    void releaseDialPlatePixmap();
 
 private:
     CLOCK_PERFORMANCE_LOG_DEFINE
     QSharedPointer<HarbourSystemState> iSystemState;
+    QSharedPointer<ClockScheduler> iScheduler;
+    QSharedPointer<ClockTimeSource> iTimeSource;
+    QSharedPointer<ClockDialCache> iDialCache;
     ClockSettings::RenderType iRenderType;
     bool iUpdatesEnabled;
     bool iInvertColors;
@@ -121,17 +158,22 @@ private:
     bool iOptimized;
     bool iRunning;
     bool iRepaintAll;
-    ClockTheme* iThemeDefault;
-    ClockTheme* iThemeInverted;
-    QList<ClockRenderer*> iRenderers;
+    int iSecHandAtlasBudget;
+    ClockSettings::AmbientMode iAmbientMode;
+    bool iAmbient;
+    int iWakeups;
+    int iRenders;
+    int iSuspendedWakeups;
+    int iSuspendedRenders;
     ClockRenderer* iRenderer;
     QuickClockLayer* iLayers;
-    QPixmap* iDialPlatePixmap;
-    QPixmap* iHourMinPixmap;
-    QTime iPaintTimeNoSec;
-    QBasicTimer iRepaintTimer;
-    int iPaintHour;
-    int iPaintMinute;
+    ClockFrameDriver* iFrameDriver;
+    ClockFrameStats* iFrameStats;
+    const QPixmap* iDialPlatePixmap;
+    ClockHourMinLayer iHourMinLayer;
+    ClockSecHandAtlas iSecHandAtlas;
+    QRect iSecHandRect;
+    QTime iPaintTime;
 };
 
 inline bool QuickClock::invertColors() const
@@ -142,11 +184,32 @@ inline bool QuickClock::running() const
     { return iRunning; }
 inline int QuickClock::renderType() const
     { return iRenderType; }
+inline int QuickClock::secHandAtlasBudget() const
+    { return iSecHandAtlasBudget; }
+inline int QuickClock::ambientMode() const
+    { return iAmbientMode; }
+inline bool QuickClock::ambient() const
+    { return iAmbient; }
+inline int QuickClock::wakeups() const
+    { return iWakeups; }
+inline int QuickClock::renders() const
+    { return iRenders; }
+inline int QuickClock::suspendedWakeups() const
+    { return iSuspendedWakeups; }
+inline int QuickClock::suspendedRenders() const
+    { return iSuspendedRenders; }
+inline QTime QuickClock::currentTime() const
+    { return iTimeSource->currentTime(); }
+inline ClockFrameStats* QuickClock::frameStats() const
+    { return iFrameStats; }
+inline QSize QuickClock::paintSize() const
+    { return QSize((int)width() & ~1, (int)height() & ~1); }
 inline QString QuickClock::style() const
     { return iRenderer->id(); }
 inline ClockRenderer* QuickClock::renderer() const
     { return iRenderer; }
 inline ClockTheme* QuickClock::theme() const
-    { return iInvertColors ? iThemeInverted : iThemeDefault; }
+    { return iInvertColors ? ClockTheme::invertedTheme() :
+        ClockTheme::defaultTheme(); }
 
 #endif // QUICK_CLOCK_H
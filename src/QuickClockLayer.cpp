@@ -44,6 +44,8 @@ QuickClockLayer::QuickClockLayer(
     QuickClock* aClock,
     ClockRenderer::NodeType aType) :
     SUPER(aParent),
+    iScheduler(ClockScheduler::sharedInstance()),
+    iFrameDriver(new ClockFrameDriver(this)),
     iClock(aClock),
     iType(aType),
     iDirty(true)
@@ -51,12 +53,19 @@ QuickClockLayer::QuickClockLayer(
     setFlags(ItemHasContents);
     setAntialiasing(true);
     setSize(QSizeF(aParent->width(), aParent->height()));
-    setVisible(aParent->isVisible());
+    setVisible(aParent->isVisible() && !hidden());
     connect(aParent, SIGNAL(widthChanged()), SLOT(onWidthChanged()));
     connect(aParent, SIGNAL(heightChanged()), SLOT(onHeightChanged()));
     connect(aParent, SIGNAL(visibleChanged()), SLOT(onVisibleChanged()));
     connect(aClock, SIGNAL(fullUpdateRequested()), SLOT(onFullUpdateRequested()));
     connect(aClock, SIGNAL(updatesEnabledChanged()), SLOT(onUpdatesEnabledChanged()));
+    connect(aClock, SIGNAL(ambientChanged()), SLOT(onAmbientChanged()));
+    connect(iFrameDriver, SIGNAL(frame()), SLOT(onFrame()));
+}
+
+QuickClockLayer::~QuickClockLayer()
+{
+    iScheduler->cancel(this);
 }
 
 void
@@ -75,6 +84,10 @@ QuickClockLayer::onUpdatesEnabledChanged()
     if (updatesEnabled()) {
         QTRACE("- requesting update");
         requestUpdate(false);
+    } else {
+        QTRACE("- stopping updates");
+        iScheduler->cancel(this);
+        iFrameDriver->cancel();
     }
 }
 
@@ -98,12 +111,36 @@ void
 QuickClockLayer::onVisibleChanged()
 {
     QTRACE(iClock->isVisible());
-    setVisible(iClock->isVisible());
-    if (iClock->isVisible()) {
+    setVisible(iClock->isVisible() && !hidden());
+    if (isVisible()) {
         requestUpdate(true);
     }
 }
 
+void
+QuickClockLayer::onAmbientChanged()
+{
+    // The second hand is hidden in ambient mode, the rest gets updated
+    // and reschedules the next update
+    setVisible(iClock->isVisible() && !hidden());
+    if (isVisible()) {
+        requestUpdate(false);
+    } else {
+        iScheduler->cancel(this);
+        iFrameDriver->cancel();
+    }
+}
+
+void
+QuickClockLayer::onFrame()
+{
+    // The previous frame has been swapped, the timer isn't needed
+    iScheduler->cancel(this);
+    if (updatesEnabled() && isVisible()) {
+        requestUpdate(false);
+    }
+}
+
 void
 QuickClockLayer::onFullUpdateRequested()
 {
@@ -113,8 +150,15 @@ QuickClockLayer::onFullUpdateRequested()
 void
 QuickClockLayer::onUpdated()
 {
-    QTime t = QuickClock::currentTime();
-    int msec = renderer()->msecUntilNextUpdate(iType, t);
+    if (!updatesEnabled()) {
+        // Will be restarted by onUpdatesEnabledChanged
+        iScheduler->cancel(this);
+        return;
+    }
+
+    // Aim at the time when the next frame is going to be seen
+    QTime t = iClock->currentTime().addMSecs(iFrameDriver->presentDelay());
+    int msec = iClock->msecUntilNextUpdate(iType, t);
     if (msec == 0) {
         requestUpdate(false);
     } else if (msec > 0) {
@@ -122,23 +166,18 @@ QuickClockLayer::onUpdated()
         if (msec < minMSec) {
             msec = minMSec;
         }
-        iRepaintTimer.start(msec, this);
+        iScheduler->schedule(this, msec, t);
+    } else {
+        iScheduler->cancel(this);
     }
 }
 
 void
-QuickClockLayer::timerEvent(
-    QTimerEvent* aEvent)
+QuickClockLayer::scheduledUpdate()
 {
-    if (aEvent->timerId() == iRepaintTimer.timerId()) {
-        if (updatesEnabled()) {
-            requestUpdate(false);
-        } else {
-            QTRACE("- stopping updates");
-            iRepaintTimer.stop();
-        }
-    } else {
-        SUPER::timerEvent(aEvent);
+    iClock->countWakeup();
+    if (updatesEnabled() && isVisible()) {
+        requestUpdate(false);
     }
 }
 
@@ -148,6 +187,10 @@ QuickClockLayer::updatePaintNode(
     QQuickItem::UpdatePaintNodeData* aData)
 {
     QSize size((int)width() & ~1, (int)height() & ~1);
+    ClockFrameStats* stats = iClock->frameStats();
+    const qint64 start = stats ? stats->now() : 0;
+
+    iClock->countRender();
 
     if (aNode && iDirty) {
         iDirty = false;
@@ -155,6 +198,20 @@ QuickClockLayer::updatePaintNode(
         aNode = NULL;
     }
 
+    if (iType == ClockRenderer::NodeDial) {
+        // The dial plate never moves
+        if (Q_UNLIKELY(!aNode)) {
+            aNode = new QSGNode;
+            renderer()->initDialPlate(aNode, window(), size, theme(),
+                iClock->drawBackground());
+        }
+        if (stats) {
+            stats->recordFrame(start, 0);
+        }
+        CLOCK_PERFORMANCE_LOG_RECORD;
+        return aNode;
+    }
+
     if (Q_UNLIKELY(!aNode)) {
         aNode = new QSGNode;
         QSGTransformNode* txNode = new QSGTransformNode;
@@ -163,15 +220,33 @@ QuickClockLayer::updatePaintNode(
     }
 
     if (aNode) {
-        QTime t = QuickClock::currentTime();
+        QTime t = iFrameDriver->presentTime();
         const QMatrix4x4 tx = renderer()->nodeMatrix(iType, size, t);
+        if (stats && iType == ClockRenderer::NodeSec) {
+            stats->recordSecHand(renderer(),
+                renderer()->nodeAngle(iType, t), t);
+        }
         for (QSGNode* n = aNode->firstChild(); n; n = n->nextSibling()) {
             if (n->type() == QSGNode::TransformNodeType) {
                 QSGTransformNode* txNode = (QSGTransformNode*)n;
                 txNode->setMatrix(tx);
             }
         }
-        QMetaObject::invokeMethod(this, "onUpdated", Qt::QueuedConnection);
+        // While the hand keeps moving, the next update is requested as
+        // soon as this frame gets swapped. Otherwise the timer is started.
+        const int msec = iClock->msecUntilNextUpdate(iType, t);
+        if (msec >= 0 && msec <= QUICK_CLOCK_MIN_UPDATE_INTERVAL &&
+            iFrameDriver->isActive() && updatesEnabled()) {
+            iFrameDriver->requestFrame();
+            if (stats) {
+                stats->recordFrame(start, iClock->frameInterval());
+            }
+        } else {
+            QMetaObject::invokeMethod(this, "onUpdated", Qt::QueuedConnection);
+            if (stats) {
+                stats->recordFrame(start, 0);
+            }
+        }
     }
 
     CLOCK_PERFORMANCE_LOG_RECORD;
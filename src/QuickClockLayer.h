@@ -36,23 +36,29 @@
 
 #include "QuickClock.h"
 #include "ClockRenderer.h"
+#include "ClockScheduler.h"
+#include "ClockFrameDriver.h"
 #include "ClockDebug.h"
 
-class QuickClockLayer: public QQuickItem {
+class QuickClockLayer: public QQuickItem, public ClockScheduler::Client {
     Q_OBJECT
 
 public:
     QuickClockLayer(QQuickItem* aParent, QuickClock* aClock, ClockRenderer::NodeType aType);
+    ~QuickClockLayer();
+
+    ClockRenderer::NodeType type() const;
 
 private:
     ClockTheme* theme() const;
     ClockRenderer* renderer() const;
     bool updatesEnabled() const;
+    bool hidden() const;
     void requestUpdate(bool aFullUpdate);
 
 protected:
     QSGNode* updatePaintNode(QSGNode* aNode, UpdatePaintNodeData* aData);
-    void timerEvent(QTimerEvent* aEvent);
+    void scheduledUpdate() Q_DECL_OVERRIDE;
 
 private Q_SLOTS:
     void onUpdatesEnabledChanged();
@@ -60,21 +66,28 @@ private Q_SLOTS:
     void onHeightChanged();
     void onVisibleChanged();
     void onFullUpdateRequested();
+    void onAmbientChanged();
+    void onFrame();
     void onUpdated();
 
 private:
     CLOCK_PERFORMANCE_LOG_DEFINE
-    QBasicTimer iRepaintTimer;
+    QSharedPointer<ClockScheduler> iScheduler;
+    ClockFrameDriver* iFrameDriver;
     QuickClock* iClock;
     ClockRenderer::NodeType iType;
     bool iDirty;
 };
 
+inline ClockRenderer::NodeType QuickClockLayer::type() const
+    { return iType; }
 inline ClockTheme* QuickClockLayer::theme() const
     { return iClock->theme(); }
 inline ClockRenderer* QuickClockLayer::renderer() const
     { return iClock->renderer(); }
 inline bool QuickClockLayer::updatesEnabled() const
     { return iClock->updatesEnabled(); }
+inline bool QuickClockLayer::hidden() const
+    { return iType == ClockRenderer::NodeSec && iClock->ambient(); }
 
 #endif // QUICK_CLOCK_LAYER_H
@@ -82,11 +82,15 @@ Q_DECL_EXPORT int main(int argc, char *argv[])
 
     // Create and set up the view
     QQuickView* view = SailfishApp::createView();
-    // Enable multisampling. The maximum number of samples that makes any
-    // difference on Jolla1 is 4. But let's try 16 anyway...
-    QSurfaceFormat format = view->format();
-    format.setSamples(16);
-    view->setFormat(format);
+    if (ClockSettings().multisampling()) {
+        // Enable multisampling. The maximum number of samples that makes
+        // any difference on Jolla1 is 4. But let's try 16 anyway...
+        QSurfaceFormat format = view->format();
+        format.setSamples(16);
+        view->setFormat(format);
+    } else {
+        HDEBUG("Multisampling is disabled");
+    }
     view->setSource(SailfishApp::pathTo(QString("qml/main.qml")));
     view->show();
 